@@ -41,9 +41,10 @@ namespace cl {
 		}
 
 #if defined(CPPCL_CL_VERSION_1_1_ENABLED)
-		Buffer<DataType> createSubBuffer(
+		template <typename ViewType>
+		Buffer<ViewType> createSubBufferView(
 			MemoryFlags const& flags,
-			size_t offset,
+			size_t offset_bytes,
 			size_t count_elements
 		) {
 			static const auto error_map = error::ErrorMap{
@@ -54,8 +55,8 @@ namespace cl {
 			};
 			auto error = cl_int{CL_SUCCESS};
 			auto buffer_region = cl_buffer_region{};
-			buffer_region.origin = offset * sizeof(DataType);
-			buffer_region.size = count_elements * sizeof(DataType);
+			buffer_region.origin = offset_bytes;
+			buffer_region.size = count_elements * sizeof(ViewType);
 			auto subbuffer_id = clCreateSubBuffer(
 				m_id,
 				flags.mask(),
@@ -66,6 +67,14 @@ namespace cl {
 			error::handle<MemoryObjectException>(error, error_map);
 			return {subbuffer_id};
 		}
+
+		Buffer<DataType> createSubBuffer(
+			MemoryFlags const& flags,
+			size_t offset,
+			size_t count_elements
+		) {
+			return createSubBufferView<DataType>(flags, offset * sizeof(DataType), count_elements);
+		}
 #endif
 
 		Buffer<DataType> associatedMemoryObject() const {
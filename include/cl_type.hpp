@@ -0,0 +1,99 @@
+#ifndef CPPCL_CL_TYPE_HEADER
+#define CPPCL_CL_TYPE_HEADER
+
+#include "wrapper.hpp"
+
+#include <string>
+
+/*
+ * ClType maps host data types to their OpenCL C counterparts
+ * so that kernels can be generated for any supported buffer type.
+ *
+ *     name       : OpenCL C type name
+ *     max        : OpenCL C expression of the largest value
+ *     lowest     : OpenCL C expression of the lowest value
+ *     extensions : OpenCL C pragmas required to use the type
+ *     scalar     : corresponding ScalarType for device queries
+ */
+
+namespace cl {
+	struct ClTypeInfo final {
+		std::string name;
+		std::string max;
+		std::string lowest;
+		std::string extensions;
+		ScalarType scalar;
+		cl_bool is_floating_point;
+		cl_bool is_signed;
+	};
+
+	class Device;
+
+	namespace detail {
+		std::string typePreamble(ClTypeInfo const& type, std::string const& alias = "T");
+
+		// Throws a DeviceException if the device cannot compute in the given floating point type.
+		void requireFloatingPoint(Device const& device, ScalarType scalar);
+	}
+
+	template <typename DataType>
+	struct ClType;
+
+	template <>
+	struct ClType<cl_char> final {
+		static ClTypeInfo info() { return {"char", "CHAR_MAX", "CHAR_MIN", "", ScalarType::char_type, false, true}; }
+	};
+
+	template <>
+	struct ClType<cl_uchar> final {
+		static ClTypeInfo info() { return {"uchar", "UCHAR_MAX", "0", "", ScalarType::char_type, false, false}; }
+	};
+
+	template <>
+	struct ClType<cl_short> final {
+		static ClTypeInfo info() { return {"short", "SHRT_MAX", "SHRT_MIN", "", ScalarType::short_type, false, true}; }
+	};
+
+	template <>
+	struct ClType<cl_ushort> final {
+		static ClTypeInfo info() { return {"ushort", "USHRT_MAX", "0", "", ScalarType::short_type, false, false}; }
+	};
+
+	template <>
+	struct ClType<cl_int> final {
+		static ClTypeInfo info() { return {"int", "INT_MAX", "INT_MIN", "", ScalarType::int_type, false, true}; }
+	};
+
+	template <>
+	struct ClType<cl_uint> final {
+		static ClTypeInfo info() { return {"uint", "UINT_MAX", "0", "", ScalarType::int_type, false, false}; }
+	};
+
+	template <>
+	struct ClType<cl_long> final {
+		static ClTypeInfo info() { return {"long", "LONG_MAX", "LONG_MIN", "", ScalarType::long_type, false, true}; }
+	};
+
+	template <>
+	struct ClType<cl_ulong> final {
+		static ClTypeInfo info() { return {"ulong", "ULONG_MAX", "0", "", ScalarType::long_type, false, false}; }
+	};
+
+	template <>
+	struct ClType<cl_float> final {
+		static ClTypeInfo info() { return {"float", "INFINITY", "(-INFINITY)", "", ScalarType::float_type, true, true}; }
+	};
+
+	template <>
+	struct ClType<cl_double> final {
+		static ClTypeInfo info() {
+			return {
+				"double", "((double)INFINITY)", "(-(double)INFINITY)",
+				"#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n",
+				ScalarType::double_type, true, true
+			};
+		}
+	};
+}
+
+#endif
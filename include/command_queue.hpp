@@ -9,12 +9,16 @@
 #include "image.hpp"
 #include "map_buffer_flags.hpp"
 #include "mapped_buffer.hpp"
+#include "kernel.hpp"
 
+#include <array>
 #include <iterator>
 #include <type_traits>
 #include <cassert>
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace cl {
 	class Context;
@@ -51,6 +55,35 @@ namespace cl {
 		}
 	};
 
+	namespace detail {
+		// Host function of CommandQueue::enqueueHost, called with the host pointers of its buffers.
+		template <typename Function, typename... DataTypes>
+		struct HostCommand final {
+			struct NativeArguments final {
+				HostCommand * command;
+				std::array<void*, sizeof...(DataTypes)> memory;
+			};
+
+			Function function;
+
+			void call(void * const* memory) {
+				call(memory, std::index_sequence_for<DataTypes...>{});
+			}
+
+			template <size_t... Indices>
+			void call(void * const* memory, std::index_sequence<Indices...>) {
+				(void) memory;
+				function(static_cast<DataTypes*>(memory[Indices])...);
+			}
+
+			static void CL_CALLBACK invokeNative(void * args) {
+				auto arguments = static_cast<NativeArguments*>(args);
+				auto command = std::unique_ptr<HostCommand>{arguments->command};
+				command->call(arguments->memory.data());
+			}
+		};
+	}
+
 	class CommandQueue final :
 		public Object<CommandQueueInfo>
 	{
@@ -93,6 +126,19 @@ namespace cl {
 						event
 					);
 				}
+				static decltype(auto) func_image(
+					cl_command_queue command_queue, cl_mem image, cl_bool blocking,
+					size_t const* origin, size_t const* region,
+					size_t row_pitch, size_t slice_pitch,
+					void * ptr,
+					cl_uint num_events_in_wait_list, cl_event const* event_wait_list,
+					cl_event * event
+				) {
+					return clEnqueueReadImage(
+						command_queue, image, blocking, origin, region, row_pitch, slice_pitch, ptr,
+						num_events_in_wait_list, event_wait_list, event
+					);
+				}
 			};
 
 			struct write final {
@@ -118,7 +164,7 @@ namespace cl {
 					size_t const* buffer_origin, size_t const* host_origin, size_t const* region,
 					size_t buffer_row_pitch, size_t buffer_slice_pitch,
 					size_t host_row_pitch, size_t host_slice_pitch,
-					void * ptr,
+					const void * ptr,
 					cl_uint num_events_in_wait_list, cl_event const* event_wait_list,
 					cl_event * event
 				) {
@@ -132,6 +178,19 @@ namespace cl {
 						event
 					);
 				}
+				static decltype(auto) func_image(
+					cl_command_queue command_queue, cl_mem image, cl_bool blocking,
+					size_t const* origin, size_t const* region,
+					size_t row_pitch, size_t slice_pitch,
+					const void * ptr,
+					cl_uint num_events_in_wait_list, cl_event const* event_wait_list,
+					cl_event * event
+				) {
+					return clEnqueueWriteImage(
+						command_queue, image, blocking, origin, region, row_pitch, slice_pitch, ptr,
+						num_events_in_wait_list, event_wait_list, event
+					);
+				}
 			};
 		};
 
@@ -209,7 +268,7 @@ namespace cl {
 					std::addressof(event_id)
 				);
 				error::handle<CommandQueueException>(error, error_map);
-				return {event_id};
+				return static_cast<typename std::conditional<Sync == CommandSync::blocking, void, Event>::type>(Event{event_id});
 			}
 		}
 		/////////////////////////////////////////////////////////////////////////
@@ -362,22 +421,26 @@ namespace cl {
 				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given buffer."},
 				{ErrorCode::invalid_operation, "can not read from buffer which has been created with write only or host-no-access attributes."}
 			};
+			// OpenCL expects the x components of offsets and region in bytes, y and z in rows and slices.
 			const auto data_size = sizeof(DataType);
 			auto buffer_off_cplt = std::array<size_t, 3>{ {0, 0, 0} };
 			auto host_off_cplt   = std::array<size_t, 3>{ {0, 0, 0} };
 			auto region_cplt     = std::array<size_t, 3>{ {1, 1, 1} };
-			for (int n = 0; n < N; ++n) {
-				buffer_off_cplt[n] = buffer_offset[n] * data_size;
-				host_off_cplt[n]   = host_offset[n] * data_size;
+			for (auto n = size_t{0}; n < N; ++n) {
+				buffer_off_cplt[n] = buffer_offset[n];
+				host_off_cplt[n]   = host_offset[n];
 				region_cplt[n]     = region[n];
 			}
+			buffer_off_cplt[0] *= data_size;
+			host_off_cplt[0]   *= data_size;
+			region_cplt[0]     *= data_size;
 			const auto num_events = (event_wait_list != nullptr)
 				? event_wait_list->size()
 				: 0;
-			auto events = (event_wait_list != nullptr)
+			auto events = (num_events > 0)
 				? reinterpret_cast<const cl_event*>(event_wait_list->data())
 				: nullptr;
-			auto first_addr = reinterpret_cast<void*>(std::addressof(*first));
+			auto first_addr = reinterpret_cast<typename Operation::convert_type>(std::addressof(*first));
 			if (Sync == CommandSync::blocking) {
 				const auto error = Operation::func_rect(
 					m_id, buffer.id(), true,
@@ -401,7 +464,7 @@ namespace cl {
 					std::addressof(event_id)
 				);
 				error::handle<CommandQueueException>(error, error_map);
-				return {event_id};
+				return static_cast<typename std::conditional<Sync == CommandSync::blocking, void, Event>::type>(Event{event_id});
 			}
 		}
 		/////////////////////////////////////////////////////////////////////////
@@ -515,6 +578,186 @@ namespace cl {
 		/////////////////////////////////////////////////////////////////////////
 #endif
 
+		/////////////////////////////////////////////////////////////////////////
+		/// READ/WRITE IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType, CommandSync Sync, typename Operation, typename Iterator>
+		typename std::conditional<Sync == CommandSync::blocking, void, Event>::type
+		enqueueReadWriteImage(
+			Image<PixelType> const& image,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			static_assert(
+				std::is_same<
+					typename std::iterator_traits<Iterator>::iterator_category,
+					std::random_access_iterator_tag
+				>::value,
+				"first has to be a random access iterator."
+			);
+			static_assert(
+				std::is_same<typename std::iterator_traits<Iterator>::value_type, PixelType>::value,
+				"the iterator has to iterate through the same pixel type as the image stores."
+			);
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue and the given image are not the same."},
+				{ErrorCode::invalid_memory_object, "the given image is invalid."},
+				{ErrorCode::invalid_value, "the region defined by origin and region is out of bounds; OR the given pointer is null."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::invalid_image_size, "the dimensions of the given image are not supported by the device associated with this command queue."},
+				{ErrorCode::image_format_not_supported, "the format of the given image is not supported by the device associated with this command queue."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given image."},
+				{ErrorCode::invalid_operation, "the device associated with this command queue does not support images; OR the image has been created with host access flags prohibiting this operation."},
+				{ErrorCode::execute_status_error_for_events_in_wait_list, "the operation is blocking and there is one or more event in the given event list with an invalid status."}
+			};
+			auto event_id = cl_event{};
+			const auto error = Operation::func_image(
+				m_id,
+				image.id(),
+				static_cast<cl_bool>(Sync),
+				origin.data(),
+				region.data(),
+				0,
+				0,
+				reinterpret_cast<typename Operation::convert_type>(std::addressof(*first)),
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				(Sync == CommandSync::blocking) ? nullptr : std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return static_cast<typename std::conditional<Sync == CommandSync::blocking, void, Event>::type>(Event{event_id});
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// READ/WRITE IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+		/////////////////////////////////////////////////////////////////////////
+		/// MAP IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType>
+		MappedImage<PixelType> enqueueMapImage(
+			Image<PixelType> const& image,
+			MapBufferFlags const& flags,
+			CommandSync sync,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue and the given image are not the same."},
+				{ErrorCode::invalid_memory_object, "the given image is invalid."},
+				{ErrorCode::invalid_value, "the region defined by origin and region is out of bounds; OR the given map flags are invalid."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::invalid_image_size, "the dimensions of the given image are not supported by the device associated with this command queue."},
+				{ErrorCode::image_format_not_supported, "the format of the given image is not supported by the device associated with this command queue."},
+				{ErrorCode::map_failure, "failed to map the requested image region into the host address space."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given image."},
+				{ErrorCode::invalid_operation, "the device associated with this command queue does not support images; OR the image has been created with host access flags prohibiting this mapping."},
+				{ErrorCode::execute_status_error_for_events_in_wait_list, "the map is blocking and there is one or more event in the given event list with an invalid status."}
+			};
+			auto row_pitch = size_t{0};
+			auto slice_pitch = size_t{0};
+			auto event_id = cl_event{0};
+			auto error = cl_int{CL_INVALID_VALUE};
+			auto ptr = reinterpret_cast<PixelType*>(
+				clEnqueueMapImage(
+					m_id,
+					image.id(),
+					static_cast<cl_bool>(sync),
+					flags.mask(),
+					origin.data(),
+					region.data(),
+					std::addressof(row_pitch),
+					std::addressof(slice_pitch),
+					events_in_wait_list.size(),
+					(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+					std::addressof(event_id),
+					std::addressof(error)
+				)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {ptr, row_pitch, slice_pitch, Event{event_id}};
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// MAP IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+		/////////////////////////////////////////////////////////////////////////
+		/// ND RANGE KERNEL - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			std::array<size_t, N> const* global_offset,
+			std::array<size_t, N> const& global_size,
+			std::array<size_t, N> const* local_size,
+			std::vector<Event> const* events_in_wait_list
+		) {
+			static_assert(N >= 1 && N <= 3, "the dimension of an nd-range has to be 1, 2 or 3.");
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_program_executable, "there is no successfully built program executable for the device associated with this command queue."},
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_kernel, "the given kernel is invalid."},
+				{ErrorCode::invalid_context, "the context of this command queue and the given kernel are not the same; OR the context of the events in the wait list is not the same."},
+				{ErrorCode::invalid_kernel_arguments, "the kernel argument values have not been specified."},
+				{ErrorCode::invalid_work_dimension, "the given nd-range dimension is not supported by the device."},
+				{ErrorCode::invalid_global_work_size, "the given global work size is null or exceeds the range of size_t on the device."},
+				{ErrorCode::invalid_global_offset, "the given global offset plus global work size exceeds the range of size_t on the device."},
+				{ErrorCode::invalid_work_group_size, "the given global work size is not evenly divisable by the given local work size; OR the local work size exceeds the kernel's or device's limits."},
+				{ErrorCode::invalid_work_item_size, "the number of work items in any dimension exceeds the device's maximum work item sizes."},
+				{ErrorCode::misaligned_sub_buffer_offset, "a sub-buffer kernel argument is not aligned to CL_DEVICE_MEM_BASE_ADDR_ALIGN value for the device associated with this command queue."},
+				{ErrorCode::invalid_image_size, "an image kernel argument has dimensions not supported by the device."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with a buffer or image kernel argument."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."}
+			};
+			const auto num_events = (events_in_wait_list != nullptr) ? events_in_wait_list->size() : 0;
+			auto event_id = cl_event{0};
+			auto error = clEnqueueNDRangeKernel(
+				m_id,
+				kernel.id(),
+				N,
+				(global_offset != nullptr) ? global_offset->data() : nullptr,
+				global_size.data(),
+				(local_size != nullptr) ? local_size->data() : nullptr,
+				num_events,
+				(num_events > 0) ? reinterpret_cast<const cl_event*>(events_in_wait_list->data()) : nullptr,
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {event_id};
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// ND RANGE KERNEL - END
+		/////////////////////////////////////////////////////////////////////////
+
+		/////////////////////////////////////////////////////////////////////////
+		/// HOST COMMAND - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		cl_bool nativeKernelSupport() const;
+
+		Event enqueueNativeKernel(
+			void (CL_CALLBACK * function)(void *),
+			void * args,
+			size_t args_size,
+			std::vector<cl_mem> const& memory_objects,
+			std::vector<const void*> const& memory_locations,
+			std::vector<Event> const& events_in_wait_list
+		);
+
+		Event enqueueHostTask(
+			std::function<void(std::vector<void*> const&)> task,
+			std::vector<cl_mem> const& memory_objects,
+			std::vector<size_t> const& sizes,
+			std::vector<Event> const& events_in_wait_list
+		);
+		/////////////////////////////////////////////////////////////////////////
+		/// HOST COMMAND - END
+		/////////////////////////////////////////////////////////////////////////
+
 	public:
 		CommandQueue(cl_command_queue command_queue_id);
 		CommandQueue(Context const& context, Device const& device, CommandQueueProperties const& properties);
@@ -524,6 +767,9 @@ namespace cl {
 		cl_uint referenceCount() const;
 		CommandQueueProperties properties() const;
 
+		void flush();
+		void finish();
+
 		/////////////////////////////////////////////////////////////////////////
 		/// READ BUFFER - BEGIN
 		/////////////////////////////////////////////////////////////////////////
@@ -1127,12 +1373,435 @@ namespace cl {
 		/////////////////////////////////////////////////////////////////////////
 #endif
 
+		/////////////////////////////////////////////////////////////////////////
+		/// READ IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType, typename Iterator>
+		void enqueueReadImage(
+			Image<PixelType> const& image,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			enqueueReadWriteImage<PixelType, CommandSync::blocking, operation::read, Iterator>(
+				image, origin, region, first, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType, typename Iterator>
+		Event enqueueReadImageAsync(
+			Image<PixelType> const& image,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueReadWriteImage<PixelType, CommandSync::async, operation::read, Iterator>(
+				image, origin, region, first, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType, typename Iterator>
+		void enqueueReadImage(
+			Image<PixelType> const& image,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			enqueueReadWriteImage<PixelType, CommandSync::blocking, operation::read, Iterator>(
+				image, {{0, 0, 0}}, image.region(), first, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType, typename Iterator>
+		Event enqueueReadImageAsync(
+			Image<PixelType> const& image,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueReadWriteImage<PixelType, CommandSync::async, operation::read, Iterator>(
+				image, {{0, 0, 0}}, image.region(), first, events_in_wait_list
+			);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// READ IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+
+		/////////////////////////////////////////////////////////////////////////
+		/// WRITE IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType, typename Iterator>
+		void enqueueWriteImage(
+			Image<PixelType> const& image,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			enqueueReadWriteImage<PixelType, CommandSync::blocking, operation::write, Iterator>(
+				image, origin, region, first, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType, typename Iterator>
+		Event enqueueWriteImageAsync(
+			Image<PixelType> const& image,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueReadWriteImage<PixelType, CommandSync::async, operation::write, Iterator>(
+				image, origin, region, first, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType, typename Iterator>
+		void enqueueWriteImage(
+			Image<PixelType> const& image,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			enqueueReadWriteImage<PixelType, CommandSync::blocking, operation::write, Iterator>(
+				image, {{0, 0, 0}}, image.region(), first, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType, typename Iterator>
+		Event enqueueWriteImageAsync(
+			Image<PixelType> const& image,
+			Iterator first,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueReadWriteImage<PixelType, CommandSync::async, operation::write, Iterator>(
+				image, {{0, 0, 0}}, image.region(), first, events_in_wait_list
+			);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// WRITE IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+
+		/////////////////////////////////////////////////////////////////////////
+		/// COPY IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType>
+		Event enqueueCopyImage(
+			Image<PixelType> const& src,
+			Image<PixelType> const& dst,
+			std::array<size_t, 3> const& src_origin,
+			std::array<size_t, 3> const& dst_origin,
+			std::array<size_t, 3> const& region,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue, the source and the destination image are not the same."},
+				{ErrorCode::invalid_memory_object, "the given source or destination image is invalid."},
+				{ErrorCode::image_format_mismatch, "the source and destination image do not use the same image format."},
+				{ErrorCode::invalid_value, "the source or destination region is out of bounds."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::invalid_image_size, "the dimensions of the given images are not supported by the device associated with this command queue."},
+				{ErrorCode::image_format_not_supported, "the format of the given images is not supported by the device associated with this command queue."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given images."},
+				{ErrorCode::invalid_operation, "the device associated with this command queue does not support images."},
+				{ErrorCode::memory_copy_overlap, "source and destination are the same image and the source and destination regions overlap."}
+			};
+			auto event_id = cl_event{0};
+			auto error = clEnqueueCopyImage(
+				m_id,
+				src.id(),
+				dst.id(),
+				src_origin.data(),
+				dst_origin.data(),
+				region.data(),
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {event_id};
+		}
+
+		template <typename PixelType>
+		Event enqueueCopyImage(
+			Image<PixelType> const& src,
+			Image<PixelType> const& dst,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueCopyImage<PixelType>(
+				src, dst, {{0, 0, 0}}, {{0, 0, 0}}, src.region(), events_in_wait_list
+			);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// COPY IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+
+		/////////////////////////////////////////////////////////////////////////
+		/// COPY IMAGE TO BUFFER / BUFFER TO IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType>
+		Event enqueueCopyImageToBuffer(
+			Image<PixelType> const& src,
+			Buffer<PixelType> const& dst,
+			std::array<size_t, 3> const& src_origin,
+			std::array<size_t, 3> const& region,
+			size_t dst_offset,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue, the source image and the destination buffer are not the same."},
+				{ErrorCode::invalid_memory_object, "the given source image or destination buffer is invalid."},
+				{ErrorCode::invalid_value, "the source region is out of bounds of the image; OR the destination region is out of bounds of the buffer."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::misaligned_sub_buffer_offset, "the destination buffer is a sub-buffer with a misaligned offset."},
+				{ErrorCode::invalid_image_size, "the dimensions of the given image are not supported by the device associated with this command queue."},
+				{ErrorCode::image_format_not_supported, "the format of the given image is not supported by the device associated with this command queue."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given image or buffer."},
+				{ErrorCode::invalid_operation, "the device associated with this command queue does not support images."}
+			};
+			auto event_id = cl_event{0};
+			auto error = clEnqueueCopyImageToBuffer(
+				m_id,
+				src.id(),
+				dst.id(),
+				src_origin.data(),
+				region.data(),
+				dst_offset * sizeof(PixelType),
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {event_id};
+		}
+
+		template <typename PixelType>
+		Event enqueueCopyImageToBuffer(
+			Image<PixelType> const& src,
+			Buffer<PixelType> const& dst,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueCopyImageToBuffer<PixelType>(
+				src, dst, {{0, 0, 0}}, src.region(), 0, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType>
+		Event enqueueCopyBufferToImage(
+			Buffer<PixelType> const& src,
+			Image<PixelType> const& dst,
+			size_t src_offset,
+			std::array<size_t, 3> const& dst_origin,
+			std::array<size_t, 3> const& region,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue, the source buffer and the destination image are not the same."},
+				{ErrorCode::invalid_memory_object, "the given source buffer or destination image is invalid."},
+				{ErrorCode::invalid_value, "the destination region is out of bounds of the image; OR the source region is out of bounds of the buffer."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::misaligned_sub_buffer_offset, "the source buffer is a sub-buffer with a misaligned offset."},
+				{ErrorCode::invalid_image_size, "the dimensions of the given image are not supported by the device associated with this command queue."},
+				{ErrorCode::image_format_not_supported, "the format of the given image is not supported by the device associated with this command queue."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given buffer or image."},
+				{ErrorCode::invalid_operation, "the device associated with this command queue does not support images."}
+			};
+			auto event_id = cl_event{0};
+			auto error = clEnqueueCopyBufferToImage(
+				m_id,
+				src.id(),
+				dst.id(),
+				src_offset * sizeof(PixelType),
+				dst_origin.data(),
+				region.data(),
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {event_id};
+		}
+
+		template <typename PixelType>
+		Event enqueueCopyBufferToImage(
+			Buffer<PixelType> const& src,
+			Image<PixelType> const& dst,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueCopyBufferToImage<PixelType>(
+				src, dst, 0, {{0, 0, 0}}, dst.region(), events_in_wait_list
+			);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// COPY IMAGE TO BUFFER / BUFFER TO IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+
+		/////////////////////////////////////////////////////////////////////////
+		/// MAP IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <typename PixelType>
+		MappedImage<PixelType> enqueueMapImage(
+			Image<PixelType> const& image,
+			MapBufferFlags const& flags,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueMapImage<PixelType>(
+				image, flags, CommandSync::blocking, origin, region, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType>
+		MappedImage<PixelType> enqueueMapImage(
+			Image<PixelType> const& image,
+			MapBufferFlags const& flags,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueMapImage<PixelType>(
+				image, flags, CommandSync::blocking, {{0, 0, 0}}, image.region(), events_in_wait_list
+			);
+		}
+
+		// The mapped data may only be accessed after the returned event completed.
+		template <typename PixelType>
+		MappedImage<PixelType> enqueueMapImageAsync(
+			Image<PixelType> const& image,
+			MapBufferFlags const& flags,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueMapImage<PixelType>(
+				image, flags, CommandSync::async, origin, region, events_in_wait_list
+			);
+		}
+
+		template <typename PixelType>
+		Event enqueueUnmapImage(
+			Image<PixelType> const& image,
+			MappedImage<PixelType> const& mapped,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_memory_object, "the given image is invalid."},
+				{ErrorCode::invalid_value, "the given mapping was not returned by a map of the given image."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue and the given image are not the same."}
+			};
+			auto event_id = cl_event{0};
+			auto error = clEnqueueUnmapMemObject(
+				m_id,
+				image.id(),
+				reinterpret_cast<void*>(mapped.data),
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {event_id};
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// MAP IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+		/////////////////////////////////////////////////////////////////////////
+		/// MAP SVM - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		// Only required for coarse-grained SVM allocations; size is given in bytes.
+		Event enqueueMapSvm(
+			void * svm_pointer,
+			size_t size,
+			MapBufferFlags const& flags,
+			CommandSync sync = CommandSync::blocking,
+			std::vector<Event> const& events_in_wait_list = {}
+		);
+
+		Event enqueueUnmapSvm(
+			void * svm_pointer,
+			std::vector<Event> const& events_in_wait_list = {}
+		);
+		/////////////////////////////////////////////////////////////////////////
+		/// MAP SVM - END
+		/////////////////////////////////////////////////////////////////////////
+#endif
+
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		/////////////////////////////////////////////////////////////////////////
+		/// FILL IMAGE - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		// The fill color is a cl_float4 for normalized and floating point formats,
+		// a cl_int4 for signed and a cl_uint4 for unsigned integer formats.
+		template <typename PixelType, typename ColorType>
+		Event enqueueFillImage(
+			Image<PixelType> const& image,
+			ColorType const& color,
+			std::array<size_t, 3> const& origin,
+			std::array<size_t, 3> const& region,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			static_assert(
+				std::is_same<ColorType, cl_float4>::value ||
+				std::is_same<ColorType, cl_int4>::value ||
+				std::is_same<ColorType, cl_uint4>::value,
+				"the fill color has to be of type cl_float4, cl_int4 or cl_uint4."
+			);
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+				{ErrorCode::invalid_context, "the context associated with this command queue and the given image are not the same."},
+				{ErrorCode::invalid_memory_object, "the given image is invalid."},
+				{ErrorCode::invalid_value, "the region defined by origin and region is out of bounds."},
+				{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+				{ErrorCode::invalid_image_size, "the dimensions of the given image are not supported by the device associated with this command queue."},
+				{ErrorCode::image_format_not_supported, "the format of the given image is not supported by the device associated with this command queue."},
+				{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given image."}
+			};
+			auto event_id = cl_event{0};
+			auto error = clEnqueueFillImage(
+				m_id,
+				image.id(),
+				reinterpret_cast<const void*>(std::addressof(color)),
+				origin.data(),
+				region.data(),
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			return {event_id};
+		}
+
+		template <typename PixelType, typename ColorType>
+		Event enqueueFillImage(
+			Image<PixelType> const& image,
+			ColorType const& color,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return enqueueFillImage<PixelType, ColorType>(
+				image, color, {{0, 0, 0}}, image.region(), events_in_wait_list
+			);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// FILL IMAGE - END
+		/////////////////////////////////////////////////////////////////////////
+#endif
+
 #if defined(CPPCL_CL_VERSION_1_2_ENABLED)
-		Event migrateMemoryObject(
+		// Flags are CL_MIGRATE_MEM_OBJECT_HOST and CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED;
+		// 0 migrates to the device of this command queue.
+		Event enqueueMigrateMemoryObjects(
 			std::vector<MemoryObject> const& memory_objects,
-			cl_mem_migration_flags flags,
-			std::vector<Event> const& event_wait_list
-		); // TODO
+			cl_mem_migration_flags flags = 0,
+			std::vector<Event> const& events_in_wait_list = {}
+		);
 
 		/////////////////////////////////////////////////////////////////////////
 		/// FILL BUFFER - BEGIN
@@ -1173,21 +1842,164 @@ namespace cl {
 			);
 		}
 		/////////////////////////////////////////////////////////////////////////
-		/// FILL BUFFER - BEGIN
+		/// FILL BUFFER - END
 		/////////////////////////////////////////////////////////////////////////
+
+		Event enqueueMarker(std::vector<Event> const& events_in_wait_list = {});
+		Event enqueueBarrier(std::vector<Event> const& events_in_wait_list = {});
 #endif
+
+		/////////////////////////////////////////////////////////////////////////
+		/// HOST COMMAND - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		// Runs function(DataTypes*...) on the host in queue order with the host
+		// pointers of the given buffers, as a native kernel if the device supports
+		// them and otherwise on ThreadPool::shared() gated by a user event between
+		// mapping and unmapping the buffers. The function must not throw on
+		// devices with native kernels; otherwise an exception fails the command.
+		template <typename Function, typename... DataTypes>
+		Event enqueueHost(
+			std::vector<Event> const& events_in_wait_list,
+			Function && function,
+			Buffer<DataTypes> const&... buffers
+		) {
+			using Command = detail::HostCommand<typename std::decay<Function>::type, DataTypes...>;
+			if (nativeKernelSupport()) {
+				auto command = std::unique_ptr<Command>{new Command{std::forward<Function>(function)}};
+				auto args = typename Command::NativeArguments{command.get(), {{static_cast<void*>(buffers.id())...}}};
+				auto locations = std::vector<const void*>{};
+				for (auto&& memory : args.memory) {
+					locations.push_back(std::addressof(memory));
+				}
+				auto event = enqueueNativeKernel(
+					&Command::invokeNative, std::addressof(args), sizeof(args),
+					{buffers.id()...}, locations, events_in_wait_list
+				);
+				command.release();
+				return event;
+			}
+			auto command = std::make_shared<Command>(Command{std::forward<Function>(function)});
+			return enqueueHostTask(
+				[command](std::vector<void*> const& pointers) { command->call(pointers.data()); },
+				{buffers.id()...}, {buffers.size()...}, events_in_wait_list
+			);
+		}
+
+		template <typename Function, typename... DataTypes>
+		Event enqueueHost(Function && function, Buffer<DataTypes> const&... buffers) {
+			return enqueueHost(std::vector<Event>{}, std::forward<Function>(function), buffers...);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// HOST COMMAND - END
+		/////////////////////////////////////////////////////////////////////////
+
+		/////////////////////////////////////////////////////////////////////////
+		/// ND RANGE KERNEL - BEGIN
+		/////////////////////////////////////////////////////////////////////////
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			std::array<size_t, N> const& global_offset,
+			std::array<size_t, N> const& global_size,
+			std::array<size_t, N> const& local_size,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			return enqueueNDRangeKernel<N>(
+				kernel, std::addressof(global_offset), global_size, std::addressof(local_size),
+				std::addressof(events_in_wait_list)
+			);
+		}
+
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			std::array<size_t, N> const& global_offset,
+			std::array<size_t, N> const& global_size,
+			std::array<size_t, N> const& local_size
+		) {
+			return enqueueNDRangeKernel<N>(
+				kernel, std::addressof(global_offset), global_size, std::addressof(local_size), nullptr
+			);
+		}
+
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			std::array<size_t, N> const& global_size,
+			std::array<size_t, N> const& local_size,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			return enqueueNDRangeKernel<N>(
+				kernel, nullptr, global_size, std::addressof(local_size),
+				std::addressof(events_in_wait_list)
+			);
+		}
+
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			std::array<size_t, N> const& global_size,
+			std::array<size_t, N> const& local_size
+		) {
+			return enqueueNDRangeKernel<N>(
+				kernel, nullptr, global_size, std::addressof(local_size), nullptr
+			);
+		}
+
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			std::array<size_t, N> const& global_size,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			return enqueueNDRangeKernel<N>(
+				kernel, nullptr, global_size, nullptr, std::addressof(events_in_wait_list)
+			);
+		}
+
+		template <size_t N>
+		Event enqueueNDRangeKernel(Kernel const& kernel, std::array<size_t, N> const& global_size) {
+			return enqueueNDRangeKernel<N>(kernel, nullptr, global_size, nullptr, nullptr);
+		}
+
+		Event enqueueNDRangeKernel(
+			Kernel const& kernel,
+			size_t global_offset,
+			size_t global_size,
+			size_t local_size,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto offset = std::array<size_t, 1>{ {global_offset} };
+			const auto global = std::array<size_t, 1>{ {global_size} };
+			const auto local  = std::array<size_t, 1>{ {local_size} };
+			return enqueueNDRangeKernel<1>(
+				kernel, std::addressof(offset), global, (local_size > 0) ? std::addressof(local) : nullptr,
+				std::addressof(events_in_wait_list)
+			);
+		}
+
+		Event enqueueNDRangeKernel(Kernel const& kernel, size_t global_size, size_t local_size = 0) {
+			const auto global = std::array<size_t, 1>{ {global_size} };
+			const auto local  = std::array<size_t, 1>{ {local_size} };
+			return enqueueNDRangeKernel<1>(
+				kernel, nullptr, global, (local_size > 0) ? std::addressof(local) : nullptr, nullptr
+			);
+		}
+		/////////////////////////////////////////////////////////////////////////
+		/// ND RANGE KERNEL - END
+		/////////////////////////////////////////////////////////////////////////
 	};
 }
 
 /*
-clGetSupportedImageFormats (Context)
+	clGetSupportedImageFormats (ImageFormatCache)
 
 	clCreateImage (Image)
 	clCreateBuffer (Buffer)
 	clCreateSubBuffer (Buffer)	
 	clGetMemObjectInfo (MemoryObject)
 
-clGetImageInfo (Image)
+	clGetImageInfo (Image)
 clRetainMemObject (MemoryObject)
 clReleaseMemObject (MemoryObject)
 clSetMemObjectDestructorCallback (MemoryObject) (OpenCL 1.1)
@@ -1201,16 +2013,18 @@ clSetMemObjectDestructorCallback (MemoryObject) (OpenCL 1.1)
 	clEnqueueCopyBufferRect
 	clEnqueueMapBuffer
 
-TODO: all image enqueue functions
-clEnqueueReadImage
-clEnqueueWriteImage
-clEnqueueFillImage (OpenCL v1.2)
-clEnqueueCopyImage
-clEnqueueMapImage
+	clEnqueueReadImage
+	clEnqueueWriteImage
+	clEnqueueFillImage (OpenCL v1.2)
+	clEnqueueCopyImage
+	clEnqueueMapImage
+	clEnqueueCopyImageToBuffer
+	clEnqueueCopyBufferToImage
+
+	clEnqueueMigrateMemObjects (OpenCL 1.2)
 
-clEnqueueCopyImageToBuffer (OpenCL 1.0) - TODO
-clEnqueueCopyBufferToImage (OpenCL 1.0) - TODO
-clEnqueueMigrateMemObjects (OpenCL 1.2) - TODO
+	clEnqueueSVMMap (OpenCL 2.0)
+	clEnqueueSVMUnmap (OpenCL 2.0)
 
 	clEnqueueUnmapMemObject (not required)
 */
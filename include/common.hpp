@@ -17,6 +17,9 @@ namespace cl {
 			const std::string& delim,
 			const bool keep_empty = true);
 
+		size_t gcd(size_t a, size_t b);
+		size_t lcm(size_t a, size_t b);
+
 		template<typename ReturnType, typename ObjectIdType, typename InfoIdType, typename InfoFunc>
 		ReturnType getInfo(ObjectIdType m_id, InfoIdType info_id, InfoFunc get_info) {
 			static const auto error_map = error::ErrorMap{
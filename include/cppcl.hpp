@@ -11,6 +11,37 @@
 #include "event.hpp"
 #include "memory_object.hpp"
 #include "buffer.hpp"
+#include "image_format.hpp"
 #include "image.hpp"
+#include "program.hpp"
+#include "kernel.hpp"
+#include "nd_range_splitter.hpp"
+#include "queue_pool.hpp"
+#include "hazard_tracker.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "reduce.hpp"
+#include "scan.hpp"
+#include "sort.hpp"
+#include "expression.hpp"
+#include "histogram.hpp"
+#include "device_hash_map.hpp"
+#include "gemm.hpp"
+#include "csr_matrix.hpp"
+#include "stencil.hpp"
+#include "fft.hpp"
+#include "random.hpp"
+#include "top_k.hpp"
+#include "segmented.hpp"
+#include "sampler.hpp"
+#include "resample.hpp"
+#include "lookup_table.hpp"
+#include "tiled_executor.hpp"
+#include "thread_pool.hpp"
+#include "task_graph.hpp"
+#include "residency_manager.hpp"
+#include "svm_allocator.hpp"
+#include "pipe.hpp"
+#include "device_selector.hpp"
 
 #endif
@@ -0,0 +1,154 @@
+#ifndef CPPCL_CSR_MATRIX_HEADER
+#define CPPCL_CSR_MATRIX_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "context.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "reduce.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ * CsrMatrix keeps a sparse matrix in compressed sparse row format resident
+ * on the device: row offsets, column indices and values.
+ *
+ * The three arrays are packed into one staging area on the host, uploaded
+ * with a single transfer into one buffer and exposed as three sub-buffers
+ * whose offsets respect the base address alignment of all context devices.
+ *
+ * spmv computes y = A * x. Short rows are processed by one work item each
+ * (scalar kernel); rows with enough non-zeros on average are processed by a
+ * group of lanes of a work-group that reduce their partial sums in local
+ * memory (vector kernel).
+ *
+ * Requires OpenCL 1.1 for sub-buffers.
+ */
+
+#if defined(CPPCL_CL_VERSION_1_1_ENABLED)
+namespace cl {
+	namespace detail {
+		struct CsrLayout final {
+			size_t column_indices_offset;
+			size_t values_offset;
+			size_t size;
+		};
+
+		CsrLayout csrLayout(Context const& context, size_t rows, size_t non_zeros, size_t value_size);
+		std::string spmvSource(ClTypeInfo const& type);
+		size_t spmvLanes(double average_row_length, size_t work_group_size);
+	}
+
+	template <typename DataType>
+	class CsrMatrix final {
+	private:
+		size_t m_rows;
+		size_t m_columns;
+		size_t m_non_zeros;
+		detail::CsrLayout m_layout;
+		Buffer<cl_uchar> m_storage;
+		Buffer<cl_uint> m_row_offsets;
+		Buffer<cl_uint> m_column_indices;
+		Buffer<DataType> m_values;
+
+	public:
+		CsrMatrix(
+			CommandQueue & queue,
+			size_t rows,
+			size_t columns,
+			std::vector<cl_uint> const& row_offsets,
+			std::vector<cl_uint> const& column_indices,
+			std::vector<DataType> const& values
+		) :
+			m_rows{rows},
+			m_columns{columns},
+			m_non_zeros{values.size()},
+			m_layout{detail::csrLayout(queue.context(), rows, values.size(), sizeof(DataType))},
+			m_storage{queue.context(), MemoryFlags{}.readOnly(true), m_layout.size},
+			m_row_offsets{m_storage.template createSubBufferView<cl_uint>(MemoryFlags{}, 0, rows + 1)},
+			m_column_indices{m_storage.template createSubBufferView<cl_uint>(
+				MemoryFlags{}, m_layout.column_indices_offset, std::max(values.size(), size_t{1}))},
+			m_values{m_storage.template createSubBufferView<DataType>(
+				MemoryFlags{}, m_layout.values_offset, std::max(values.size(), size_t{1}))}
+		{
+			assert(row_offsets.size() == rows + 1);
+			assert(column_indices.size() == values.size());
+			assert(row_offsets.back() == values.size());
+			auto staging = std::vector<cl_uchar>(m_layout.size);
+			std::memcpy(staging.data(), row_offsets.data(), row_offsets.size() * sizeof(cl_uint));
+			std::memcpy(
+				staging.data() + m_layout.column_indices_offset,
+				column_indices.data(),
+				column_indices.size() * sizeof(cl_uint)
+			);
+			std::memcpy(staging.data() + m_layout.values_offset, values.data(), values.size() * sizeof(DataType));
+			queue.enqueueWrite(m_storage, staging.begin(), staging.end());
+		}
+
+		size_t rows() const {
+			return m_rows;
+		}
+
+		size_t columns() const {
+			return m_columns;
+		}
+
+		size_t nonZeros() const {
+			return m_non_zeros;
+		}
+
+		double averageRowLength() const {
+			return (m_rows == 0) ? 0.0 : static_cast<double>(m_non_zeros) / static_cast<double>(m_rows);
+		}
+
+		Buffer<cl_uint> const& rowOffsets() const {
+			return m_row_offsets;
+		}
+
+		Buffer<cl_uint> const& columnIndices() const {
+			return m_column_indices;
+		}
+
+		Buffer<DataType> const& values() const {
+			return m_values;
+		}
+	};
+
+	template <typename DataType>
+	Event spmv(
+		CommandQueue & queue,
+		CsrMatrix<DataType> const& matrix,
+		Buffer<DataType> const& x,
+		Buffer<DataType> const& y,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		assert(x.count_elements() >= matrix.columns());
+		assert(y.count_elements() >= matrix.rows());
+		detail::requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+		const auto program = ProgramCache::get(queue.context(), detail::spmvSource(ClType<DataType>::info()));
+		auto vector_kernel = Kernel{program, "cppcl_spmv_vector"};
+		const auto local_size = detail::reduceWorkGroupSize(queue.device(), vector_kernel, sizeof(DataType));
+		const auto lanes = detail::spmvLanes(matrix.averageRowLength(), local_size);
+		const auto rows = cl_uint(matrix.rows());
+		if (lanes == 1) {
+			auto scalar_kernel = Kernel{program, "cppcl_spmv_scalar"};
+			scalar_kernel.setArgs(rows, matrix.rowOffsets(), matrix.columnIndices(), matrix.values(), x, y);
+			return queue.enqueueNDRangeKernel(scalar_kernel, 0, matrix.rows(), 0, events_in_wait_list);
+		}
+		vector_kernel.setArgs(
+			rows, matrix.rowOffsets(), matrix.columnIndices(), matrix.values(), x, y,
+			cl_uint(lanes), LocalMemory<DataType>{local_size}
+		);
+		const auto global_size = (matrix.rows() * lanes + local_size - 1) / local_size * local_size;
+		return queue.enqueueNDRangeKernel(vector_kernel, 0, global_size, local_size, events_in_wait_list);
+	}
+}
+#endif
+
+#endif
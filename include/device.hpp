@@ -98,6 +98,20 @@ namespace cl {
 
 		size_t maxDepthImage3D() const;
 
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		size_t maxBufferSizeImage1D() const;
+#endif
+
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+		cl_device_svm_capabilities svmCapabilities() const;
+
+		cl_uint maxPipeArguments() const;
+
+		cl_uint pipeMaxActiveReservations() const;
+
+		cl_uint pipeMaxPacketSize() const;
+#endif
+
 		cl_ulong localMemorySize() const;
 
 		DeviceLocalMemoryType localMemoryType() const;
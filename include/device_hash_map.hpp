@@ -0,0 +1,187 @@
+#ifndef CPPCL_DEVICE_HASH_MAP_HEADER
+#define CPPCL_DEVICE_HASH_MAP_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "context.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "scan.hpp"
+
+#include <cassert>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * DeviceHashMap is an open-addressing hash table resident in one buffer:
+ * a power of two number of key slots followed by the value slots.
+ *
+ * Slots are probed linearly starting at a murmur3 finalizer hash of the key.
+ * Inserts claim slots by atomic compare-and-swap on the key, so the bulk
+ * operations insert, find and contains run as one kernel launch each over a
+ * buffer of keys. Inserting an existing key overwrites its value; concurrent
+ * inserts of the same key keep one of the values.
+ *
+ * Keys are 32-bit or 64-bit integers; 64-bit keys require the
+ * cl_khr_int64_base_atomics extension. The key with all bits set marks empty
+ * slots and cannot be stored. Inserts into a full table are dropped and
+ * counted by failedInserts.
+ */
+
+namespace cl {
+	namespace detail {
+		std::string hashMapSource(ClTypeInfo const& key, size_t key_size, ClTypeInfo const& value);
+		size_t hashMapCapacity(size_t count_elements);
+		size_t hashMapValuesOffset(size_t capacity, size_t key_size);
+	}
+
+	template <typename KeyType, typename ValueType>
+	class DeviceHashMap final {
+	private:
+		static_assert(
+			std::is_integral<KeyType>::value && (sizeof(KeyType) == 4 || sizeof(KeyType) == 8),
+			"hash map keys have to be 32-bit or 64-bit integers."
+		);
+
+		size_t m_capacity;
+		size_t m_values_offset;
+		Buffer<cl_uchar> m_table;
+		Buffer<cl_uint> m_failed;
+		Program m_program;
+		std::vector<Event> m_cleared;
+
+		std::vector<Event> waitList(std::vector<Event> const& events_in_wait_list) const {
+			auto events = events_in_wait_list;
+			events.insert(events.end(), m_cleared.begin(), m_cleared.end());
+			return events;
+		}
+
+	public:
+		DeviceHashMap(CommandQueue & queue, size_t count_elements, std::vector<Event> const& events_in_wait_list = {}) :
+			m_capacity{detail::hashMapCapacity(count_elements)},
+			m_values_offset{detail::hashMapValuesOffset(m_capacity, sizeof(KeyType))},
+			m_table{queue.context(), MemoryFlags{}.readWrite(true), m_values_offset + m_capacity * sizeof(ValueType)},
+			m_failed{queue.context(), MemoryFlags{}.readWrite(true), 1},
+			m_program{ProgramCache::get(queue.context(), detail::hashMapSource(
+				ClType<KeyType>::info(), sizeof(KeyType), ClType<ValueType>::info()))},
+			m_cleared{}
+		{
+			auto clear = Kernel{m_program, "cppcl_hash_map_clear"};
+			clear.setArgs(m_table, cl_ulong{m_capacity}, m_failed);
+			m_cleared.push_back(queue.enqueueNDRangeKernel(clear, 0, m_capacity, 0, events_in_wait_list));
+		}
+
+		Event insert(
+			CommandQueue & queue,
+			Buffer<KeyType> const& keys,
+			Buffer<ValueType> const& values,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			assert(values.count_elements() >= keys.count_elements());
+			auto kernel = Kernel{m_program, "cppcl_hash_map_insert"};
+			kernel.setArgs(
+				m_table, cl_ulong{m_capacity}, cl_ulong{m_values_offset}, m_failed,
+				keys, values, cl_uint{1}, cl_ulong{keys.count_elements()}
+			);
+			return queue.enqueueNDRangeKernel(kernel, 0, keys.count_elements(), 0, waitList(events_in_wait_list));
+		}
+
+		// Maps every key to its index within keys.
+		Event insertIndices(
+			CommandQueue & queue,
+			Buffer<KeyType> const& keys,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			static_assert(std::is_integral<ValueType>::value, "indices can only be stored as integral values.");
+			auto kernel = Kernel{m_program, "cppcl_hash_map_insert"};
+			kernel.setArgs(
+				m_table, cl_ulong{m_capacity}, cl_ulong{m_values_offset}, m_failed,
+				keys, m_table, cl_uint{0}, cl_ulong{keys.count_elements()}
+			);
+			return queue.enqueueNDRangeKernel(kernel, 0, keys.count_elements(), 0, waitList(events_in_wait_list));
+		}
+
+		Event find(
+			CommandQueue & queue,
+			Buffer<KeyType> const& keys,
+			Buffer<ValueType> const& values,
+			ValueType missing,
+			std::vector<Event> const& events_in_wait_list = {}
+		) const {
+			assert(values.count_elements() >= keys.count_elements());
+			auto kernel = Kernel{m_program, "cppcl_hash_map_find"};
+			kernel.setArgs(
+				m_table, cl_ulong{m_capacity}, cl_ulong{m_values_offset},
+				keys, values, missing, cl_ulong{keys.count_elements()}
+			);
+			return queue.enqueueNDRangeKernel(kernel, 0, keys.count_elements(), 0, waitList(events_in_wait_list));
+		}
+
+		Event contains(
+			CommandQueue & queue,
+			Buffer<KeyType> const& keys,
+			Buffer<cl_uint> const& found,
+			std::vector<Event> const& events_in_wait_list = {}
+		) const {
+			assert(found.count_elements() >= keys.count_elements());
+			auto kernel = Kernel{m_program, "cppcl_hash_map_contains"};
+			kernel.setArgs(m_table, cl_ulong{m_capacity}, keys, found, cl_ulong{keys.count_elements()});
+			return queue.enqueueNDRangeKernel(kernel, 0, keys.count_elements(), 0, waitList(events_in_wait_list));
+		}
+
+		// Writes the pairs (value of the matching entry, index of the probe key)
+		// for all probe keys found in the map; their order is unspecified.
+		CompactResult join(
+			CommandQueue & queue,
+			Buffer<KeyType> const& probe_keys,
+			Buffer<ValueType> const& matched_values,
+			Buffer<cl_uint> const& matched_indices,
+			std::vector<Event> const& events_in_wait_list = {}
+		) const {
+			auto result = Buffer<cl_uint>{queue.context(), MemoryFlags{}.readWrite(true), 1};
+			auto kernel = Kernel{m_program, "cppcl_hash_map_join"};
+			kernel.setArgs(
+				m_table, cl_ulong{m_capacity}, cl_ulong{m_values_offset},
+				probe_keys, cl_ulong{probe_keys.count_elements()}, matched_values, matched_indices, result
+			);
+			auto reset = Kernel{m_program, "cppcl_hash_map_reset_counter"};
+			reset.setArgs(result);
+			auto event = queue.enqueueNDRangeKernel(reset, 0, 1, 0, waitList(events_in_wait_list));
+			event = queue.enqueueNDRangeKernel(kernel, 0, probe_keys.count_elements(), 0, std::vector<Event>{event});
+			return {result, event};
+		}
+
+		size_t capacity() const {
+			return m_capacity;
+		}
+
+		Buffer<cl_uchar> const& table() const {
+			return m_table;
+		}
+
+		Buffer<cl_uint> const& failedInserts() const {
+			return m_failed;
+		}
+	};
+
+	// Hash join of unique build keys with arbitrary probe keys: writes the
+	// matching (build index, probe index) pairs and leaves their count on the device.
+	template <typename KeyType>
+	CompactResult hashJoin(
+		CommandQueue & queue,
+		Buffer<KeyType> const& build_keys,
+		Buffer<KeyType> const& probe_keys,
+		Buffer<cl_uint> const& build_indices,
+		Buffer<cl_uint> const& probe_indices,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		auto map = DeviceHashMap<KeyType, cl_uint>{queue, build_keys.count_elements(), events_in_wait_list};
+		const auto event = map.insertIndices(queue, build_keys);
+		return map.join(queue, probe_keys, build_indices, probe_indices, std::vector<Event>{event});
+	}
+}
+
+#endif
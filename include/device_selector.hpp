@@ -0,0 +1,84 @@
+#ifndef CPPCL_DEVICE_SELECTOR_HEADER
+#define CPPCL_DEVICE_SELECTOR_HEADER
+
+#include "device.hpp"
+
+#include <string>
+#include <vector>
+
+/*
+ * DeviceSelector ranks devices by short micro-benchmarks instead of driver
+ * order:
+ *
+ *     auto devices = platform.getDevices(DeviceType::all);
+ *     auto device = DeviceSelector::best(devices, DeviceScoreWeights{}.fma(4.0));
+ *
+ * Every device is measured once for host to device and device to host
+ * bandwidth (blocking transfers), device copy bandwidth, FMA throughput and
+ * kernel launch latency. Transfer sizes follow the allocation limit of the
+ * device and the FMA kernel doubles its iteration count until a launch takes
+ * long enough to time reliably; every figure is the best of a few runs.
+ *
+ * Profiles are cached by platform name, device name and driver version, so
+ * identical devices are measured once and a driver update measures again.
+ * save() and load() keep the cache in a text file between runs.
+ *
+ * The score of a device is the weighted sum of the logarithms of its figures
+ * relative to the best candidate (latency inverted), so every weight scales
+ * a ratio and no unit dominates. Devices whose benchmarks fail score
+ * -infinity and are ranked last; only if no device can be measured at all
+ * a DeviceException is thrown.
+ */
+
+namespace cl {
+	struct DeviceProfile final {
+		double host_to_device_bandwidth; // bytes per second
+		double device_to_host_bandwidth; // bytes per second
+		double device_copy_bandwidth;    // bytes per second
+		double fma_throughput;           // floating point operations per second
+		double launch_latency;           // seconds
+	};
+
+	class DeviceScoreWeights final {
+	public:
+		DeviceScoreWeights();
+
+		DeviceScoreWeights & hostToDevice(double weight);
+		DeviceScoreWeights & deviceToHost(double weight);
+		DeviceScoreWeights & deviceCopy(double weight);
+		DeviceScoreWeights & fma(double weight);
+		DeviceScoreWeights & launchLatency(double weight);
+
+		double hostToDevice() const;
+		double deviceToHost() const;
+		double deviceCopy() const;
+		double fma() const;
+		double launchLatency() const;
+
+	private:
+		double m_host_to_device;
+		double m_device_to_host;
+		double m_device_copy;
+		double m_fma;
+		double m_launch_latency;
+	};
+
+	class DeviceSelector final {
+	public:
+		static DeviceProfile profile(Device const& device);
+
+		// Sorted from the best to the worst device.
+		static std::vector<Device> rank(
+			std::vector<Device> const& devices, DeviceScoreWeights const& weights = {});
+		static Device best(
+			std::vector<Device> const& devices, DeviceScoreWeights const& weights = {});
+		static std::vector<double> scores(
+			std::vector<Device> const& devices, DeviceScoreWeights const& weights = {});
+
+		static void save(std::string const& path);
+		static void load(std::string const& path);
+		static void clear();
+	};
+}
+
+#endif
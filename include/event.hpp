@@ -5,7 +5,9 @@
 #include "context.hpp"
 //#include "command_queue.hpp"
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace cl {
 	class CommandQueue;
@@ -63,6 +65,7 @@ namespace cl {
 	class Event final : public Object<EventInfo> {
 	private:
 		void setStatus(CommandExecutionStatus status);
+		cl_ulong getProfilingInfo(cl_profiling_info info_id) const;
 
 	public:
 		Event(cl_event event_id);
@@ -84,8 +87,20 @@ namespace cl {
 		CommandExecutionStatus status() const;
 		cl_uint referenceCount() const;
 
+		cl_ulong profilingCommandQueued() const;
+		cl_ulong profilingCommandSubmit() const;
+		cl_ulong profilingCommandStart() const;
+		cl_ulong profilingCommandEnd() const;
+
 		static void waitForEvents(std::vector<Event> const& events);
 	};
+
+	namespace detail {
+		// Calls continuation(failed) once all events completed, without blocking any thread:
+		// right away for no events, otherwise from the completion callback of the last one.
+		// Continuations run on OpenCL runtime threads and should only hand work off.
+		void whenComplete(std::vector<Event> events, std::function<void(cl_bool)> continuation);
+	}
 }
 
 #endif
@@ -32,6 +32,7 @@ namespace cl {
 	class MemoryObjectException final : public Exception { using Exception::Exception; };
 	class KernelException final       : public Exception { using Exception::Exception; };
 	class CommandQueueException final : public Exception { using Exception::Exception; };
+	class SamplerException final      : public Exception { using Exception::Exception; };
 }
 
 #endif
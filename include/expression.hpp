@@ -0,0 +1,381 @@
+#ifndef CPPCL_EXPRESSION_HEADER
+#define CPPCL_EXPRESSION_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <cassert>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Lazy element-wise expressions over buffers.
+ *
+ * Arithmetic on buffers, scalars and the functions below does not touch the
+ * device, it builds an expression tree whose shape is encoded in its type:
+ *
+ *     auto event = cl::assign(queue, c, a * 2.0f + cl::sqrt(b));
+ *
+ * assign generates one OpenCL C kernel evaluating the whole tree per element
+ * and launches it once, so there are no intermediate buffers. The kernel
+ * source depends only on the expression type and is generated once per type;
+ * its program is built once per context by the ProgramCache.
+ *
+ * Scalars are passed as kernel arguments converted to the element type of
+ * the other operand, so changing their values does not cause a rebuild.
+ */
+
+namespace cl {
+	namespace expression {
+		struct add final {
+			static std::string apply(std::string const& a, std::string const& b) { return "(" + a + " + " + b + ")"; }
+		};
+
+		struct subtract final {
+			static std::string apply(std::string const& a, std::string const& b) { return "(" + a + " - " + b + ")"; }
+		};
+
+		struct multiply final {
+			static std::string apply(std::string const& a, std::string const& b) { return "(" + a + " * " + b + ")"; }
+		};
+
+		struct divide final {
+			static std::string apply(std::string const& a, std::string const& b) { return "(" + a + " / " + b + ")"; }
+		};
+
+		struct minimum final {
+			static std::string apply(std::string const& a, std::string const& b) { return "min(" + a + ", " + b + ")"; }
+		};
+
+		struct maximum final {
+			static std::string apply(std::string const& a, std::string const& b) { return "max(" + a + ", " + b + ")"; }
+		};
+
+		struct negate final {
+			static std::string apply(std::string const& a) { return "(-" + a + ")"; }
+		};
+
+		struct sqrt final {
+			static std::string apply(std::string const& a) { return "sqrt(" + a + ")"; }
+		};
+
+		struct exp final {
+			static std::string apply(std::string const& a) { return "exp(" + a + ")"; }
+		};
+
+		struct log final {
+			static std::string apply(std::string const& a) { return "log(" + a + ")"; }
+		};
+	}
+
+	template <typename DataType>
+	class BufferExpression final {
+	private:
+		Buffer<DataType> m_buffer;
+
+	public:
+		using value_type = DataType;
+
+		explicit BufferExpression(Buffer<DataType> const& buffer) :
+			m_buffer{buffer}
+		{}
+
+		static void declare(std::string & parameters, std::string & extensions, cl_uint & index) {
+			const auto info = ClType<DataType>::info();
+			parameters += ",\n\t__global const " + info.name + " * a" + std::to_string(index++);
+			extensions += info.extensions;
+		}
+
+		static std::string source(cl_uint & index) {
+			return "a" + std::to_string(index++) + "[i]";
+		}
+
+		void bind(Kernel & kernel, cl_uint & index) const {
+			kernel.setArg(index++, m_buffer);
+		}
+
+		void check(size_t count_elements) const {
+			assert(m_buffer.count_elements() >= count_elements);
+			(void)count_elements;
+		}
+	};
+
+	template <typename DataType>
+	class ScalarExpression final {
+	private:
+		DataType m_value;
+
+	public:
+		using value_type = DataType;
+
+		explicit ScalarExpression(DataType value) :
+			m_value{value}
+		{}
+
+		static void declare(std::string & parameters, std::string & extensions, cl_uint & index) {
+			const auto info = ClType<DataType>::info();
+			parameters += ",\n\t" + info.name + " a" + std::to_string(index++);
+			extensions += info.extensions;
+		}
+
+		static std::string source(cl_uint & index) {
+			return "a" + std::to_string(index++);
+		}
+
+		void bind(Kernel & kernel, cl_uint & index) const {
+			kernel.setArg(index++, m_value);
+		}
+
+		void check(size_t) const {}
+	};
+
+	template <typename Operation, typename Operand>
+	class UnaryExpression final {
+	private:
+		Operand m_operand;
+
+	public:
+		using value_type = typename Operand::value_type;
+
+		explicit UnaryExpression(Operand operand) :
+			m_operand{operand}
+		{}
+
+		static void declare(std::string & parameters, std::string & extensions, cl_uint & index) {
+			Operand::declare(parameters, extensions, index);
+		}
+
+		static std::string source(cl_uint & index) {
+			return Operation::apply(Operand::source(index));
+		}
+
+		void bind(Kernel & kernel, cl_uint & index) const {
+			m_operand.bind(kernel, index);
+		}
+
+		void check(size_t count_elements) const {
+			m_operand.check(count_elements);
+		}
+	};
+
+	template <typename Operation, typename Left, typename Right>
+	class BinaryExpression final {
+	private:
+		Left m_left;
+		Right m_right;
+
+	public:
+		using value_type = typename std::common_type<
+			typename Left::value_type, typename Right::value_type>::type;
+
+		BinaryExpression(Left left, Right right) :
+			m_left{left},
+			m_right{right}
+		{}
+
+		static void declare(std::string & parameters, std::string & extensions, cl_uint & index) {
+			Left::declare(parameters, extensions, index);
+			Right::declare(parameters, extensions, index);
+		}
+
+		static std::string source(cl_uint & index) {
+			const auto left = Left::source(index);
+			return Operation::apply(left, Right::source(index));
+		}
+
+		void bind(Kernel & kernel, cl_uint & index) const {
+			m_left.bind(kernel, index);
+			m_right.bind(kernel, index);
+		}
+
+		void check(size_t count_elements) const {
+			m_left.check(count_elements);
+			m_right.check(count_elements);
+		}
+	};
+
+	namespace detail {
+		template <typename T>
+		struct IsExpression : std::false_type {};
+
+		template <typename DataType>
+		struct IsExpression<Buffer<DataType>> : std::true_type {};
+
+		template <typename DataType>
+		struct IsExpression<BufferExpression<DataType>> : std::true_type {};
+
+		template <typename DataType>
+		struct IsExpression<ScalarExpression<DataType>> : std::true_type {};
+
+		template <typename Operation, typename Operand>
+		struct IsExpression<UnaryExpression<Operation, Operand>> : std::true_type {};
+
+		template <typename Operation, typename Left, typename Right>
+		struct IsExpression<BinaryExpression<Operation, Left, Right>> : std::true_type {};
+
+		template <typename T>
+		struct ExpressionOf {
+			using type = T;
+			static T const& make(T const& expression) { return expression; }
+		};
+
+		template <typename DataType>
+		struct ExpressionOf<Buffer<DataType>> {
+			using type = BufferExpression<DataType>;
+			static type make(Buffer<DataType> const& buffer) { return type{buffer}; }
+		};
+
+		template <typename Left, typename Right, typename = void>
+		struct BinaryOperands;
+
+		template <typename Left, typename Right>
+		struct BinaryOperands<Left, Right, typename std::enable_if<
+			IsExpression<Left>::value && IsExpression<Right>::value>::type> {
+			using left_type = typename ExpressionOf<Left>::type;
+			using right_type = typename ExpressionOf<Right>::type;
+			static left_type left(Left const& l) { return ExpressionOf<Left>::make(l); }
+			static right_type right(Right const& r) { return ExpressionOf<Right>::make(r); }
+		};
+
+		template <typename Left, typename Right>
+		struct BinaryOperands<Left, Right, typename std::enable_if<
+			IsExpression<Left>::value && std::is_arithmetic<Right>::value>::type> {
+			using left_type = typename ExpressionOf<Left>::type;
+			using right_type = ScalarExpression<typename left_type::value_type>;
+			static left_type left(Left const& l) { return ExpressionOf<Left>::make(l); }
+			static right_type right(Right const& r) { return right_type{static_cast<typename right_type::value_type>(r)}; }
+		};
+
+		template <typename Left, typename Right>
+		struct BinaryOperands<Left, Right, typename std::enable_if<
+			std::is_arithmetic<Left>::value && IsExpression<Right>::value>::type> {
+			using right_type = typename ExpressionOf<Right>::type;
+			using left_type = ScalarExpression<typename right_type::value_type>;
+			static left_type left(Left const& l) { return left_type{static_cast<typename left_type::value_type>(l)}; }
+			static right_type right(Right const& r) { return ExpressionOf<Right>::make(r); }
+		};
+
+		template <typename Operation, typename Left, typename Right>
+		using BinaryResult = BinaryExpression<
+			Operation,
+			typename BinaryOperands<Left, Right>::left_type,
+			typename BinaryOperands<Left, Right>::right_type
+		>;
+
+		template <typename Operation, typename Left, typename Right>
+		BinaryResult<Operation, Left, Right> makeBinary(Left const& left, Right const& right) {
+			using Operands = BinaryOperands<Left, Right>;
+			return {Operands::left(left), Operands::right(right)};
+		}
+
+		template <typename Operation, typename Operand>
+		using UnaryResult = typename std::enable_if<
+			IsExpression<Operand>::value,
+			UnaryExpression<Operation, typename ExpressionOf<Operand>::type>
+		>::type;
+
+		template <typename Operation, typename Operand>
+		UnaryResult<Operation, Operand> makeUnary(Operand const& operand) {
+			return UnaryResult<Operation, Operand>{ExpressionOf<Operand>::make(operand)};
+		}
+
+		std::string fusedSource(
+			ClTypeInfo const& output,
+			std::string const& extensions,
+			std::string const& parameters,
+			std::string const& expression
+		);
+
+		template <typename DataType, typename Expression>
+		std::string const& fusedSource() {
+			static const auto source = [] {
+				auto parameters = std::string{};
+				auto extensions = std::string{};
+				auto index = cl_uint{0};
+				Expression::declare(parameters, extensions, index);
+				index = 0;
+				return fusedSource(ClType<DataType>::info(), extensions, parameters, Expression::source(index));
+			}();
+			return source;
+		}
+	}
+
+	template <typename Left, typename Right>
+	detail::BinaryResult<expression::add, Left, Right> operator+(Left const& left, Right const& right) {
+		return detail::makeBinary<expression::add>(left, right);
+	}
+
+	template <typename Left, typename Right>
+	detail::BinaryResult<expression::subtract, Left, Right> operator-(Left const& left, Right const& right) {
+		return detail::makeBinary<expression::subtract>(left, right);
+	}
+
+	template <typename Left, typename Right>
+	detail::BinaryResult<expression::multiply, Left, Right> operator*(Left const& left, Right const& right) {
+		return detail::makeBinary<expression::multiply>(left, right);
+	}
+
+	template <typename Left, typename Right>
+	detail::BinaryResult<expression::divide, Left, Right> operator/(Left const& left, Right const& right) {
+		return detail::makeBinary<expression::divide>(left, right);
+	}
+
+	template <typename Left, typename Right>
+	detail::BinaryResult<expression::minimum, Left, Right> min(Left const& left, Right const& right) {
+		return detail::makeBinary<expression::minimum>(left, right);
+	}
+
+	template <typename Left, typename Right>
+	detail::BinaryResult<expression::maximum, Left, Right> max(Left const& left, Right const& right) {
+		return detail::makeBinary<expression::maximum>(left, right);
+	}
+
+	template <typename Operand>
+	detail::UnaryResult<expression::negate, Operand> operator-(Operand const& operand) {
+		return detail::makeUnary<expression::negate>(operand);
+	}
+
+	template <typename Operand>
+	detail::UnaryResult<expression::sqrt, Operand> sqrt(Operand const& operand) {
+		return detail::makeUnary<expression::sqrt>(operand);
+	}
+
+	template <typename Operand>
+	detail::UnaryResult<expression::exp, Operand> exp(Operand const& operand) {
+		return detail::makeUnary<expression::exp>(operand);
+	}
+
+	template <typename Operand>
+	detail::UnaryResult<expression::log, Operand> log(Operand const& operand) {
+		return detail::makeUnary<expression::log>(operand);
+	}
+
+	template <typename DataType, typename Expression>
+	typename std::enable_if<detail::IsExpression<Expression>::value, Event>::type
+	assign(
+		CommandQueue & queue,
+		Buffer<DataType> const& output,
+		Expression const& expression,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		using Tree = typename detail::ExpressionOf<Expression>::type;
+		const auto& tree = detail::ExpressionOf<Expression>::make(expression);
+		const auto count = output.count_elements();
+		tree.check(count);
+		detail::requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+		const auto program = ProgramCache::get(queue.context(), detail::fusedSource<DataType, Tree>());
+		auto kernel = Kernel{program, "cppcl_fused"};
+		kernel.setArgs(output, cl_ulong{count});
+		auto index = cl_uint{2};
+		tree.bind(kernel, index);
+		return queue.enqueueNDRangeKernel(kernel, 0, count, 0, events_in_wait_list);
+	}
+}
+
+#endif
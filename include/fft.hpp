@@ -0,0 +1,211 @@
+#ifndef CPPCL_FFT_HEADER
+#define CPPCL_FFT_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "context.hpp"
+#include "device.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+ * Complex fast Fourier transforms over Buffer<cl_float2> and Buffer<cl_double2>
+ * with 1, 2 or 3 dimensions of extents {x, y, z}, x being the fastest-varying
+ * dimension, and any number of transforms stored back to back (batch).
+ *
+ * Every dimension is transformed by out-of-place Stockham passes of radix
+ * 4, 2, 3 or 5, so the extents have to factor into these radices.
+ * Passes read their twiddle factors from a table of exp(-2 pi i m / n)
+ * that is computed once per (context, device, n) and shared by all plans.
+ *
+ * An FftPlan builds its kernels and scratch buffer up front; executing it
+ * only sets arguments and enqueues one launch per pass. Inverse transforms
+ * are not normalized. Plans may not be executed concurrently from several threads.
+ */
+
+namespace cl {
+	namespace detail {
+		template <typename ComplexType>
+		struct FftTraits;
+
+		template <>
+		struct FftTraits<cl_float2> final {
+			using real_type = cl_float;
+			static ClTypeInfo info() { return ClType<cl_float>::info(); }
+		};
+
+		template <>
+		struct FftTraits<cl_double2> final {
+			using real_type = cl_double;
+			static ClTypeInfo info() { return ClType<cl_double>::info(); }
+		};
+
+		std::string fftSource(ClTypeInfo const& real);
+		std::vector<size_t> fftRadices(size_t n);
+
+		template <typename ComplexType>
+		Buffer<ComplexType> fftTwiddles(CommandQueue & queue, size_t n) {
+			using Key = std::tuple<cl_context, cl_device_id, size_t>;
+			static auto cache = std::map<Key, Buffer<ComplexType>>{};
+			static std::mutex mutex;
+			const auto context = queue.context();
+			const auto key = Key{context.id(), queue.device().id(), n};
+			std::lock_guard<std::mutex> lock{mutex};
+			const auto it = cache.find(key);
+			if (it != cache.end()) return it->second;
+			const auto pi = std::acos(-1.0);
+			auto host = std::vector<ComplexType>(n);
+			for (auto m = size_t{0}; m < n; ++m) {
+				const auto angle = -2.0 * pi * static_cast<double>(m) / static_cast<double>(n);
+				host[m].s[0] = static_cast<typename FftTraits<ComplexType>::real_type>(std::cos(angle));
+				host[m].s[1] = static_cast<typename FftTraits<ComplexType>::real_type>(std::sin(angle));
+			}
+			auto twiddles = Buffer<ComplexType>{context, MemoryFlags{}.readOnly(true), n};
+			queue.enqueueWrite(twiddles, host.begin(), host.end());
+			cache.emplace(key, twiddles);
+			return twiddles;
+		}
+	}
+
+	template <typename ComplexType>
+	class FftPlan final {
+	private:
+		struct Pass final {
+			size_t radix;
+			size_t n;
+			size_t stride;
+			size_t span;
+			size_t lines;
+			size_t twiddles;
+		};
+
+		std::vector<size_t> m_extent;
+		size_t m_batch;
+		size_t m_count_elements;
+		std::vector<Kernel> m_kernels;
+		std::vector<Buffer<ComplexType>> m_twiddles;
+		std::vector<Pass> m_passes;
+		Buffer<ComplexType> m_scratch;
+
+		Kernel & kernel(size_t radix) {
+			switch (radix) {
+				case 2: return m_kernels[0];
+				case 3: return m_kernels[1];
+				case 4: return m_kernels[2];
+				default: return m_kernels[3];
+			}
+		}
+
+		Event execute(
+			CommandQueue & queue,
+			Buffer<ComplexType> const& data,
+			cl_int inverse,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			assert(data.count_elements() >= m_count_elements);
+			auto wait = events_in_wait_list;
+			const Buffer<ComplexType> * input = &data;
+			const Buffer<ComplexType> * output = &m_scratch;
+			for (auto&& pass : m_passes) {
+				auto & pass_kernel = kernel(pass.radix);
+				pass_kernel.setArgs(
+					*input, *output, m_twiddles[pass.twiddles],
+					cl_uint(pass.n), cl_uint(pass.stride), cl_uint(pass.span), inverse
+				);
+				const auto event = queue.enqueueNDRangeKernel(
+					pass_kernel, std::array<size_t, 2>{{pass.n / pass.radix, pass.lines}}, wait);
+				wait = std::vector<Event>{event};
+				std::swap(input, output);
+			}
+			if (input != &data) {
+				const auto event = queue.enqueueCopyBuffer(m_scratch, data, 0, 0, m_count_elements, wait);
+				wait = std::vector<Event>{event};
+			}
+			return wait.front();
+		}
+
+	public:
+		template <size_t N>
+		FftPlan(CommandQueue & queue, std::array<size_t, N> const& extent, size_t batch = 1) :
+			m_extent(extent.begin(), extent.end()),
+			m_batch{batch},
+			m_count_elements{batch},
+			m_kernels{},
+			m_twiddles{},
+			m_passes{},
+			m_scratch{
+				queue.context(), MemoryFlags{}.readWrite(true),
+				std::max(std::accumulate(extent.begin(), extent.end(), batch, std::multiplies<size_t>{}), size_t{1})
+			}
+		{
+			static_assert(N >= 1 && N <= 3, "fft plans support 1, 2 or 3 dimensions.");
+			const auto context = queue.context();
+			const auto info = detail::FftTraits<ComplexType>::info();
+			detail::requireFloatingPoint(queue.device(), info.scalar);
+			const auto source = detail::fftSource(info);
+			for (auto radix : {2, 3, 4, 5}) {
+				m_kernels.emplace_back(
+					ProgramCache::get(context, source, "-D RADIX=" + std::to_string(radix)), "cppcl_fft_pass");
+			}
+			for (auto&& n : extent) m_count_elements *= n;
+			auto stride = size_t{1};
+			for (auto&& n : extent) {
+				m_twiddles.push_back(detail::fftTwiddles<ComplexType>(queue, n));
+				auto span = size_t{1};
+				for (auto radix : detail::fftRadices(n)) {
+					m_passes.push_back(Pass{radix, n, stride, span, m_count_elements / n, m_twiddles.size() - 1});
+					span *= radix;
+				}
+				stride *= n;
+			}
+		}
+
+		FftPlan(CommandQueue & queue, size_t n, size_t batch = 1) :
+			FftPlan{queue, std::array<size_t, 1>{{n}}, batch}
+		{}
+
+		Event forward(
+			CommandQueue & queue,
+			Buffer<ComplexType> const& data,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return execute(queue, data, 0, events_in_wait_list);
+		}
+
+		Event inverse(
+			CommandQueue & queue,
+			Buffer<ComplexType> const& data,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			return execute(queue, data, 1, events_in_wait_list);
+		}
+
+		std::vector<size_t> const& extent() const {
+			return m_extent;
+		}
+
+		size_t batch() const {
+			return m_batch;
+		}
+
+		size_t countPasses() const {
+			return m_passes.size();
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef CPPCL_GEMM_HEADER
+#define CPPCL_GEMM_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "device.hpp"
+#include "exception.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <array>
+#include <cassert>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * General matrix multiplication C = alpha * A * B + beta * C on row-major
+ * float and double matrices with leading dimensions lda, ldb and ldc.
+ *
+ * gemm tiles C into TILE x TILE blocks per work-group staged through local
+ * memory; every work item accumulates WORK_PER_ITEM elements of a row in
+ * registers. Tile sizes are compile-time constants of the generated program,
+ * derived from the device's preferredVectorWidth and localMemorySize.
+ *
+ * gemmBatched multiplies many small matrices stored back to back in one
+ * launch with one work item per element of C.
+ *
+ * The double precision variants throw a DeviceException on devices without
+ * double precision support.
+ */
+
+namespace cl {
+	namespace detail {
+		struct GemmTiling final {
+			size_t tile;
+			size_t work_per_item;
+		};
+
+		std::string gemmSource(ClTypeInfo const& type);
+		std::string gemmOptions(GemmTiling const& tiling);
+		GemmTiling gemmTiling(Device const& device, ScalarType scalar, size_t element_size, size_t max_work_group_size);
+
+		template <typename DataType>
+		Kernel gemmKernel(Context const& context, Device const& device, std::string const& name, GemmTiling & tiling) {
+			const auto info = ClType<DataType>::info();
+			requireFloatingPoint(device, info.scalar);
+			auto max_work_group_size = device.maxWorkGroupSize();
+			while (true) {
+				tiling = gemmTiling(device, info.scalar, sizeof(DataType), max_work_group_size);
+				auto kernel = Kernel{ProgramCache::get(context, gemmSource(info), gemmOptions(tiling)), name};
+				const auto work_group_size = tiling.tile * tiling.tile / tiling.work_per_item;
+				const auto supported = kernel.workGroupSize(device);
+				if (work_group_size <= supported || work_group_size == 1) return kernel;
+				max_work_group_size = supported;
+			}
+		}
+	}
+
+	template <typename DataType>
+	Event gemm(
+		CommandQueue & queue,
+		size_t m, size_t n, size_t k,
+		DataType alpha,
+		Buffer<DataType> const& a, size_t lda,
+		Buffer<DataType> const& b, size_t ldb,
+		DataType beta,
+		Buffer<DataType> const& c, size_t ldc,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		static_assert(
+			std::is_same<DataType, cl_float>::value || std::is_same<DataType, cl_double>::value,
+			"gemm is only available for float and double matrices."
+		);
+		assert(lda >= k && ldb >= n && ldc >= n);
+		assert(a.count_elements() >= (m - 1) * lda + k);
+		assert(b.count_elements() >= (k - 1) * ldb + n);
+		assert(c.count_elements() >= (m - 1) * ldc + n);
+		auto tiling = detail::GemmTiling{};
+		auto kernel = detail::gemmKernel<DataType>(queue.context(), queue.device(), "cppcl_gemm", tiling);
+		kernel.setArgs(
+			cl_uint(m), cl_uint(n), cl_uint(k), alpha,
+			a, cl_uint(lda), b, cl_uint(ldb), beta, c, cl_uint(ldc)
+		);
+		const auto tiles_n = (n + tiling.tile - 1) / tiling.tile;
+		const auto tiles_m = (m + tiling.tile - 1) / tiling.tile;
+		const auto local = std::array<size_t, 2>{{tiling.tile / tiling.work_per_item, tiling.tile}};
+		return queue.enqueueNDRangeKernel(
+			kernel,
+			std::array<size_t, 2>{{tiles_n * local[0], tiles_m * local[1]}},
+			local,
+			events_in_wait_list
+		);
+	}
+
+	template <typename DataType>
+	Event gemmBatched(
+		CommandQueue & queue,
+		size_t m, size_t n, size_t k,
+		DataType alpha,
+		Buffer<DataType> const& a,
+		Buffer<DataType> const& b,
+		DataType beta,
+		Buffer<DataType> const& c,
+		size_t batch,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		static_assert(
+			std::is_same<DataType, cl_float>::value || std::is_same<DataType, cl_double>::value,
+			"gemm is only available for float and double matrices."
+		);
+		assert(a.count_elements() >= batch * m * k);
+		assert(b.count_elements() >= batch * k * n);
+		assert(c.count_elements() >= batch * m * n);
+		auto tiling = detail::GemmTiling{};
+		auto kernel = detail::gemmKernel<DataType>(queue.context(), queue.device(), "cppcl_gemm_batched", tiling);
+		kernel.setArgs(cl_uint(m), cl_uint(n), cl_uint(k), alpha, a, b, beta, c);
+		return queue.enqueueNDRangeKernel(
+			kernel,
+			std::array<size_t, 3>{{n, m, batch}},
+			events_in_wait_list
+		);
+	}
+}
+
+#endif
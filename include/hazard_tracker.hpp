@@ -0,0 +1,202 @@
+#ifndef CPPCL_HAZARD_TRACKER_HEADER
+#define CPPCL_HAZARD_TRACKER_HEADER
+
+#include "command_queue.hpp"
+#include "memory_object.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+
+#include <array>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * HazardTracker infers event wait lists for commands on out-of-order queues.
+ *
+ * For every memory object it remembers the events of outstanding readers and
+ * writers together with the byte range they access. Sub-buffers are tracked as
+ * ranges of their associated memory object. A command submitted through the
+ * tracker waits only for:
+ *     read after write  : overlapping writers
+ *     write after read  : overlapping readers
+ *     write after write : overlapping writers
+ * Records whose events have completed are pruned before each submission and
+ * records fully covered by a new write are superseded by it.
+ */
+
+namespace cl {
+	enum class AccessMode {
+		read,
+		write,
+		read_write
+	};
+
+	struct MemoryAccess final {
+		cl_mem memory_object;
+		size_t begin;
+		size_t end;
+		AccessMode mode;
+	};
+
+	class HazardTracker final {
+	private:
+		struct Record final {
+			size_t begin;
+			size_t end;
+			cl_bool write;
+			Event event;
+		};
+
+		std::unordered_map<cl_mem, std::vector<Record>> m_records;
+		std::mutex m_mutex;
+
+		static MemoryAccess access(MemoryObject const& memory_object, size_t offset, size_t size, AccessMode mode);
+
+		std::vector<Event> dependencies(std::vector<MemoryAccess> const& accesses);
+		void record(std::vector<MemoryAccess> const& accesses, Event const& event);
+
+	public:
+		HazardTracker() = default;
+		HazardTracker(HazardTracker const&) = delete;
+		HazardTracker & operator=(HazardTracker const&) = delete;
+
+		template <typename DataType>
+		static MemoryAccess read(Buffer<DataType> const& buffer, size_t offset, size_t count_elements) {
+			return access(buffer, offset * sizeof(DataType), count_elements * sizeof(DataType), AccessMode::read);
+		}
+
+		template <typename DataType>
+		static MemoryAccess read(Buffer<DataType> const& buffer) {
+			return access(buffer, 0, buffer.size(), AccessMode::read);
+		}
+
+		template <typename DataType>
+		static MemoryAccess write(Buffer<DataType> const& buffer, size_t offset, size_t count_elements) {
+			return access(buffer, offset * sizeof(DataType), count_elements * sizeof(DataType), AccessMode::write);
+		}
+
+		template <typename DataType>
+		static MemoryAccess write(Buffer<DataType> const& buffer) {
+			return access(buffer, 0, buffer.size(), AccessMode::write);
+		}
+
+		template <typename DataType>
+		static MemoryAccess readWrite(Buffer<DataType> const& buffer) {
+			return access(buffer, 0, buffer.size(), AccessMode::read_write);
+		}
+
+		static MemoryAccess read(MemoryObject const& memory_object);
+		static MemoryAccess write(MemoryObject const& memory_object);
+		static MemoryAccess readWrite(MemoryObject const& memory_object);
+
+		template <typename Command>
+		Event submit(std::vector<MemoryAccess> const& accesses, Command command) {
+			std::lock_guard<std::mutex> lock{m_mutex};
+			const auto events = dependencies(accesses);
+			auto event = Event{command(events)};
+			record(accesses, event);
+			return event;
+		}
+
+		void prune();
+		void clear();
+		size_t countOutstanding();
+
+		template <typename DataType, typename Iterator>
+		Event enqueueRead(
+			CommandQueue & queue,
+			Buffer<DataType> const& buffer,
+			Iterator first,
+			Iterator last,
+			size_t buffer_offset = 0
+		) {
+			const auto count = static_cast<size_t>(std::distance(first, last));
+			return submit({read(buffer, buffer_offset, count)}, [&](std::vector<Event> const& events) {
+				return queue.enqueueReadAsync(buffer, first, last, buffer_offset, events);
+			});
+		}
+
+		template <typename DataType, typename Iterator>
+		Event enqueueWrite(
+			CommandQueue & queue,
+			Buffer<DataType> const& buffer,
+			Iterator first,
+			Iterator last,
+			size_t buffer_offset = 0
+		) {
+			const auto count = static_cast<size_t>(std::distance(first, last));
+			return submit({write(buffer, buffer_offset, count)}, [&](std::vector<Event> const& events) {
+				return queue.enqueueWriteAsync(buffer, first, last, buffer_offset, events);
+			});
+		}
+
+		template <typename DataType>
+		Event enqueueCopyBuffer(
+			CommandQueue & queue,
+			Buffer<DataType> const& src,
+			Buffer<DataType> const& dst,
+			size_t offset_src,
+			size_t offset_dst,
+			size_t count_elements
+		) {
+			const auto accesses = std::vector<MemoryAccess>{
+				read(src, offset_src, count_elements),
+				write(dst, offset_dst, count_elements)
+			};
+			return submit(accesses, [&](std::vector<Event> const& events) {
+				return queue.enqueueCopyBuffer(src, dst, offset_src, offset_dst, count_elements, events);
+			});
+		}
+
+		template <typename DataType>
+		Event enqueueCopyBuffer(CommandQueue & queue, Buffer<DataType> const& src, Buffer<DataType> const& dst) {
+			return enqueueCopyBuffer(queue, src, dst, 0, 0, src.count_elements());
+		}
+
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		template <typename DataType>
+		Event enqueueFillBuffer(
+			CommandQueue & queue,
+			Buffer<DataType> const& buffer,
+			DataType const& value,
+			size_t offset,
+			size_t count_elements
+		) {
+			return submit({write(buffer, offset, count_elements)}, [&](std::vector<Event> const& events) {
+				return queue.enqueueFillBuffer(buffer, value, offset, count_elements, events);
+			});
+		}
+#endif
+
+		template <size_t N>
+		Event enqueueNDRangeKernel(
+			CommandQueue & queue,
+			Kernel const& kernel,
+			std::vector<MemoryAccess> const& accesses,
+			std::array<size_t, N> const& global_offset,
+			std::array<size_t, N> const& global_size,
+			std::array<size_t, N> const& local_size
+		) {
+			return submit(accesses, [&](std::vector<Event> const& events) {
+				return queue.enqueueNDRangeKernel(kernel, global_offset, global_size, local_size, events);
+			});
+		}
+
+		Event enqueueNDRangeKernel(
+			CommandQueue & queue,
+			Kernel const& kernel,
+			std::vector<MemoryAccess> const& accesses,
+			size_t global_size,
+			size_t local_size = 0
+		) {
+			return submit(accesses, [&](std::vector<Event> const& events) {
+				return queue.enqueueNDRangeKernel(kernel, 0, global_size, local_size, events);
+			});
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef CPPCL_HISTOGRAM_HEADER
+#define CPPCL_HISTOGRAM_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "device.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <string>
+#include <vector>
+
+/*
+ * Device-side histogram over uniform bins of [lower, upper).
+ * Values outside of the range are not counted.
+ *
+ * On devices with dedicated local memory every work-group counts into
+ * privatized sub-histograms in local memory, several copies of them if
+ * they fit so that neighbouring work items do not contend for the same
+ * counters, and merges them into the result with one atomic per bin.
+ * Bin ranges too large for local memory are processed in chunks along the
+ * second nd-range dimension. Devices emulating local memory in global memory
+ * and very large bin counts use global atomics directly.
+ */
+
+namespace cl {
+	struct HistogramResult final {
+		Buffer<cl_uint> counts;
+		Event event;
+	};
+
+	namespace detail {
+		struct HistogramStrategy final {
+			cl_bool privatized;
+			size_t local_size;
+			size_t groups;
+			size_t copies;
+			size_t chunk;
+			size_t chunks;
+		};
+
+		std::string histogramSource(ClTypeInfo const& type);
+		HistogramStrategy histogramStrategy(Device const& device, Kernel const& kernel, size_t count, size_t bins);
+	}
+
+	template <typename DataType>
+	HistogramResult histogram(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		size_t bins,
+		DataType lower,
+		DataType upper,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		const auto context = queue.context();
+		detail::requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+		const auto program = ProgramCache::get(context, detail::histogramSource(ClType<DataType>::info()));
+		auto clear = Kernel{program, "cppcl_histogram_clear"};
+		auto kernel = Kernel{program, "cppcl_histogram_local"};
+		const auto count = input.count_elements();
+		const auto strategy = detail::histogramStrategy(queue.device(), kernel, count, bins);
+		auto counts = Buffer<cl_uint>{context, MemoryFlags{}.readWrite(true), bins};
+		clear.setArgs(counts, cl_uint(bins));
+		auto event = queue.enqueueNDRangeKernel(clear, 0, bins, 0, events_in_wait_list);
+		if (strategy.privatized) {
+			kernel.setArgs(
+				input, cl_ulong{count}, cl_uint(bins), lower, upper,
+				cl_uint(strategy.copies), cl_uint(strategy.chunk), counts,
+				LocalMemory<cl_uint>{strategy.copies * strategy.chunk}
+			);
+			event = queue.enqueueNDRangeKernel(
+				kernel,
+				std::array<size_t, 2>{{strategy.groups * strategy.local_size, strategy.chunks}},
+				std::array<size_t, 2>{{strategy.local_size, 1}},
+				std::vector<Event>{event}
+			);
+		} else {
+			auto global = Kernel{program, "cppcl_histogram_global"};
+			global.setArgs(input, cl_ulong{count}, cl_uint(bins), lower, upper, counts);
+			event = queue.enqueueNDRangeKernel(
+				global, 0, strategy.groups * strategy.local_size, strategy.local_size, std::vector<Event>{event});
+		}
+		return {counts, event};
+	}
+
+	template <typename DataType>
+	HistogramResult histogram(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		size_t bins,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return histogram(
+			queue, input, bins, DataType{0}, static_cast<DataType>(bins), events_in_wait_list);
+	}
+}
+
+#endif
@@ -2,14 +2,268 @@
 #define CPPCL_IMAGE_HEADER
 
 #include "memory_object.hpp"
+#include "buffer.hpp"
+#include "image_format.hpp"
+#include "event.hpp"
+
+#include <array>
+#include <type_traits>
+
+/*
+ * Typed images: the pixel type together with a ChannelOrder and a ChannelType
+ * fixes the image format at compile time; order and type default to the
+ * natural format of the pixel type given by ImageFormat<PixelType>.
+ *
+ *     auto image = Image2D<cl_uchar4>{context, flags, 640, 480};
+ *     auto other = Image2D<cl_uchar4, ChannelOrder::bgra>{context, flags, 640, 480};
+ *
+ * Construction checks the format against the (cached) list of formats
+ * supported by the context and throws a MemoryObjectException with
+ * ErrorCode::image_format_not_supported otherwise.
+ *
+ * Image1D, Image1DBuffer and Image2DArray require OpenCL 1.2. Origins and
+ * regions of image commands are always given in pixels as {x, y, z}; unused
+ * dimensions are 0 for origins and 1 for regions, array layers take the next
+ * free dimension.
+ */
 
 namespace cl {
+	namespace detail {
+		struct ImageDescription final {
+			MemoryObjectType type;
+			size_t width;
+			size_t height;
+			size_t depth;
+			size_t array_size;
+			size_t row_pitch;
+			size_t slice_pitch;
+			cl_mem buffer;
+		};
+
+		cl_mem createImage(
+			Context const& context,
+			MemoryFlags const& flags,
+			cl_image_format const& format,
+			ImageDescription const& description,
+			void * host_ptr
+		);
+
+		size_t imageInfoSize(cl_mem image, cl_image_info info_id);
+		cl_image_format imageInfoFormat(cl_mem image);
+		std::array<size_t, 3> imageRegion(cl_mem image);
+
+		template <typename PixelType, ChannelOrder Order, ChannelType Type>
+		cl_image_format imageFormat() {
+			static_assert(
+				std::is_trivial<PixelType>::value,
+				"the pixel type of an image has to be trivial."
+			);
+			static_assert(
+				pixelSize(Order, Type) != 0,
+				"the given channel order and channel type do not form a valid image format."
+			);
+			static_assert(
+				pixelSize(Order, Type) == sizeof(PixelType),
+				"the size of the pixel type has to match the pixel size of the image format."
+			);
+			return ImageFormatBase<Order, Type>::format();
+		}
+	}
+
+	template <typename PixelType>
+	struct MappedImage final {
+		PixelType * data;
+		size_t row_pitch;
+		size_t slice_pitch;
+		Event event;
+	};
+
+	template <typename PixelType>
+	class Image : public MemoryObject {
+	protected:
+		Image(cl_mem mem) :
+			MemoryObject{mem}
+		{}
+
+	public:
+		using pixel_type = PixelType;
+
+		cl_image_format format() const {
+			return detail::imageInfoFormat(m_id);
+		}
+
+		size_t elementSize() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_ELEMENT_SIZE);
+		}
+
+		size_t rowPitch() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_ROW_PITCH);
+		}
+
+		size_t slicePitch() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_SLICE_PITCH);
+		}
+
+		size_t width() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_WIDTH);
+		}
+
+		size_t height() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_HEIGHT);
+		}
+
+		size_t depth() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_DEPTH);
+		}
 
-	template <typename DataType>
-	class Image final : public MemoryObject {
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		size_t arraySize() const {
+			return detail::imageInfoSize(m_id, CL_IMAGE_ARRAY_SIZE);
+		}
+#endif
+
+		// The region covering the whole image, usable with every image command.
+		std::array<size_t, 3> region() const {
+			return detail::imageRegion(m_id);
+		}
+	};
+
+	template <
+		typename PixelType,
+		ChannelOrder Order = ImageFormat<PixelType>::order,
+		ChannelType Type = ImageFormat<PixelType>::type
+	>
+	class Image2D final : public Image<PixelType> {
+	public:
+		Image2D(cl_mem mem) :
+			Image<PixelType>{mem}
+		{}
+
+		Image2D(
+			Context const& context,
+			MemoryFlags const& flags,
+			size_t width,
+			size_t height,
+			PixelType * host_ptr = nullptr,
+			size_t row_pitch = 0
+		) :
+			Image<PixelType>{detail::createImage(
+				context, flags, detail::imageFormat<PixelType, Order, Type>(),
+				{MemoryObjectType::image2d, width, height, 1, 1, row_pitch, 0, nullptr},
+				host_ptr
+			)}
+		{}
+	};
+
+	template <
+		typename PixelType,
+		ChannelOrder Order = ImageFormat<PixelType>::order,
+		ChannelType Type = ImageFormat<PixelType>::type
+	>
+	class Image3D final : public Image<PixelType> {
+	public:
+		Image3D(cl_mem mem) :
+			Image<PixelType>{mem}
+		{}
+
+		Image3D(
+			Context const& context,
+			MemoryFlags const& flags,
+			size_t width,
+			size_t height,
+			size_t depth,
+			PixelType * host_ptr = nullptr,
+			size_t row_pitch = 0,
+			size_t slice_pitch = 0
+		) :
+			Image<PixelType>{detail::createImage(
+				context, flags, detail::imageFormat<PixelType, Order, Type>(),
+				{MemoryObjectType::image3d, width, height, depth, 1, row_pitch, slice_pitch, nullptr},
+				host_ptr
+			)}
+		{}
+	};
+
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+	template <
+		typename PixelType,
+		ChannelOrder Order = ImageFormat<PixelType>::order,
+		ChannelType Type = ImageFormat<PixelType>::type
+	>
+	class Image1D final : public Image<PixelType> {
+	public:
+		Image1D(cl_mem mem) :
+			Image<PixelType>{mem}
+		{}
+
+		Image1D(
+			Context const& context,
+			MemoryFlags const& flags,
+			size_t width,
+			PixelType * host_ptr = nullptr
+		) :
+			Image<PixelType>{detail::createImage(
+				context, flags, detail::imageFormat<PixelType, Order, Type>(),
+				{MemoryObjectType::image1d, width, 1, 1, 1, 0, 0, nullptr},
+				host_ptr
+			)}
+		{}
+	};
 
+	// Shares the data store of the given buffer; its width is the element count of the buffer.
+	template <
+		typename PixelType,
+		ChannelOrder Order = ImageFormat<PixelType>::order,
+		ChannelType Type = ImageFormat<PixelType>::type
+	>
+	class Image1DBuffer final : public Image<PixelType> {
+	public:
+		Image1DBuffer(cl_mem mem) :
+			Image<PixelType>{mem}
+		{}
+
+		Image1DBuffer(
+			Context const& context,
+			MemoryFlags const& flags,
+			Buffer<PixelType> const& buffer
+		) :
+			Image<PixelType>{detail::createImage(
+				context, flags, detail::imageFormat<PixelType, Order, Type>(),
+				{MemoryObjectType::image1d_buffer, buffer.count_elements(), 1, 1, 1, 0, 0, buffer.id()},
+				nullptr
+			)}
+		{}
 	};
 
+	template <
+		typename PixelType,
+		ChannelOrder Order = ImageFormat<PixelType>::order,
+		ChannelType Type = ImageFormat<PixelType>::type
+	>
+	class Image2DArray final : public Image<PixelType> {
+	public:
+		Image2DArray(cl_mem mem) :
+			Image<PixelType>{mem}
+		{}
+
+		Image2DArray(
+			Context const& context,
+			MemoryFlags const& flags,
+			size_t width,
+			size_t height,
+			size_t array_size,
+			PixelType * host_ptr = nullptr,
+			size_t row_pitch = 0,
+			size_t slice_pitch = 0
+		) :
+			Image<PixelType>{detail::createImage(
+				context, flags, detail::imageFormat<PixelType, Order, Type>(),
+				{MemoryObjectType::image2d_array, width, height, 1, array_size, row_pitch, slice_pitch, nullptr},
+				host_ptr
+			)}
+		{}
+	};
+#endif
 }
 
 #endif
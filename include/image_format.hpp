@@ -0,0 +1,139 @@
+#ifndef CPPCL_IMAGE_FORMAT_HEADER
+#define CPPCL_IMAGE_FORMAT_HEADER
+
+#include "wrapper.hpp"
+#include "context.hpp"
+#include "memory_flags.hpp"
+
+#include <vector>
+
+/*
+ * Image formats are derived at compile time from a ChannelOrder, a
+ * ChannelType and the host pixel type: ImageFormat<PixelType> names the
+ * natural format of a pixel type (e.g. cl_uchar4 -> rgba / unorm_int8) and
+ * detail::pixelSize checks that a chosen order and type match the size
+ * of the host pixel type.
+ *
+ * ImageFormatCache queries clGetSupportedImageFormats once per context,
+ * access flags and image type and answers all further lookups from memory.
+ * Cached contexts stay alive until ImageFormatCache::clear().
+ */
+
+namespace cl {
+	namespace detail {
+		constexpr size_t channelCount(ChannelOrder order) {
+			switch (order) {
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+				case ChannelOrder::rx:
+#endif
+				case ChannelOrder::a:
+				case ChannelOrder::r:
+				case ChannelOrder::intensity:
+				case ChannelOrder::luminance: return 1;
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+				case ChannelOrder::rgx:
+#endif
+				case ChannelOrder::rg:
+				case ChannelOrder::ra: return 2;
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+				case ChannelOrder::rgbx:
+#endif
+				case ChannelOrder::rgb: return 3;
+				case ChannelOrder::rgba:
+				case ChannelOrder::bgra:
+				case ChannelOrder::argb: return 4;
+			}
+			return 0;
+		}
+
+		constexpr bool isPackedChannelType(ChannelType type) {
+			return type == ChannelType::t_unorm_int101010
+				|| type == ChannelType::t_unorm_short_555
+				|| type == ChannelType::t_unorm_short_565;
+		}
+
+		// Bytes per channel; for packed channel types bytes per pixel.
+		constexpr size_t channelTypeSize(ChannelType type) {
+			switch (type) {
+				case ChannelType::t_signed_int8:
+				case ChannelType::t_unsigned_int8:
+				case ChannelType::t_snorm_int8:
+				case ChannelType::t_unorm_int8: return 1;
+				case ChannelType::t_half_float:
+				case ChannelType::t_signed_int16:
+				case ChannelType::t_unsigned_int16:
+				case ChannelType::t_snorm_int16:
+				case ChannelType::t_unorm_int16:
+				case ChannelType::t_unorm_short_555:
+				case ChannelType::t_unorm_short_565: return 2;
+				case ChannelType::t_float:
+				case ChannelType::t_signed_int32:
+				case ChannelType::t_unsigned_int32:
+				case ChannelType::t_unorm_int101010: return 4;
+			}
+			return 0;
+		}
+
+		// Returns 0 for combinations OpenCL does not define (packed types require rgb or rgbx).
+		constexpr size_t pixelSize(ChannelOrder order, ChannelType type) {
+			return (isPackedChannelType(type))
+				? ((channelCount(order) == 3) ? channelTypeSize(type) : 0)
+				: ((channelCount(order) == 3) ? 0 : channelCount(order) * channelTypeSize(type));
+		}
+
+		template <ChannelOrder Order, ChannelType Type>
+		struct ImageFormatBase {
+			static constexpr ChannelOrder order = Order;
+			static constexpr ChannelType type = Type;
+
+			static cl_image_format format() {
+				auto format = cl_image_format{};
+				format.image_channel_order = static_cast<cl_channel_order>(Order);
+				format.image_channel_data_type = static_cast<cl_channel_type>(Type);
+				return format;
+			}
+		};
+
+		template <ChannelOrder Order, ChannelType Type>
+		constexpr ChannelOrder ImageFormatBase<Order, Type>::order;
+
+		template <ChannelOrder Order, ChannelType Type>
+		constexpr ChannelType ImageFormatBase<Order, Type>::type;
+	}
+
+	template <typename PixelType>
+	struct ImageFormat;
+
+	template <> struct ImageFormat<cl_char>    final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_snorm_int8> {};
+	template <> struct ImageFormat<cl_char2>   final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_snorm_int8> {};
+	template <> struct ImageFormat<cl_char4>   final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_snorm_int8> {};
+	template <> struct ImageFormat<cl_uchar>   final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_unorm_int8> {};
+	template <> struct ImageFormat<cl_uchar2>  final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_unorm_int8> {};
+	template <> struct ImageFormat<cl_uchar4>  final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_unorm_int8> {};
+	template <> struct ImageFormat<cl_short>   final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_snorm_int16> {};
+	template <> struct ImageFormat<cl_short2>  final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_snorm_int16> {};
+	template <> struct ImageFormat<cl_short4>  final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_snorm_int16> {};
+	template <> struct ImageFormat<cl_ushort>  final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_unorm_int16> {};
+	template <> struct ImageFormat<cl_ushort2> final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_unorm_int16> {};
+	template <> struct ImageFormat<cl_ushort4> final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_unorm_int16> {};
+	template <> struct ImageFormat<cl_int>     final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_signed_int32> {};
+	template <> struct ImageFormat<cl_int2>    final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_signed_int32> {};
+	template <> struct ImageFormat<cl_int4>    final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_signed_int32> {};
+	template <> struct ImageFormat<cl_uint>    final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_unsigned_int32> {};
+	template <> struct ImageFormat<cl_uint2>   final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_unsigned_int32> {};
+	template <> struct ImageFormat<cl_uint4>   final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_unsigned_int32> {};
+	template <> struct ImageFormat<cl_float>   final : detail::ImageFormatBase<ChannelOrder::r,    ChannelType::t_float> {};
+	template <> struct ImageFormat<cl_float2>  final : detail::ImageFormatBase<ChannelOrder::rg,   ChannelType::t_float> {};
+	template <> struct ImageFormat<cl_float4>  final : detail::ImageFormatBase<ChannelOrder::rgba, ChannelType::t_float> {};
+
+	class ImageFormatCache final {
+	public:
+		static std::vector<cl_image_format> get(
+			Context const& context, MemoryFlags const& flags, MemoryObjectType type);
+		static bool supports(
+			Context const& context, MemoryFlags const& flags, MemoryObjectType type, cl_image_format const& format);
+		static void clear();
+	};
+}
+
+#endif
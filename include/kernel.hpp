@@ -0,0 +1,139 @@
+#ifndef CPPCL_KERNEL_HEADER
+#define CPPCL_KERNEL_HEADER
+
+#include "object.hpp"
+#include "program.hpp"
+#include "memory_object.hpp"
+#include "error_handler.hpp"
+
+#include <type_traits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cl {
+	class KernelException;
+	class Sampler;
+
+	struct KernelInfo final {
+	private:
+		static const error::ErrorMap error_map;
+
+	public:
+		using cl_type = cl_kernel;
+		using info_type = cl_kernel_info;
+		using exception_type = KernelException;
+
+		static decltype(auto) func_release(cl_kernel id) {
+			error::handle<KernelException>(clReleaseKernel(id), error_map);
+		}
+
+		static decltype(auto) func_retain(cl_kernel id) {
+			error::handle<KernelException>(clRetainKernel(id), error_map);
+		}
+
+		static decltype(auto) func_info
+		(
+			cl_kernel kernel,
+			cl_kernel_info param_name,
+			size_t param_value_size,
+			void *param_value,
+			size_t *param_value_size_ret
+		) {
+			return clGetKernelInfo(
+				kernel, param_name, param_value_size, param_value, param_value_size_ret);
+		}
+	};
+
+	template <typename DataType>
+	struct LocalMemory final {
+		explicit LocalMemory(size_t count_elements) :
+			m_count_elements{count_elements}
+		{}
+
+		size_t count_elements() const {
+			return m_count_elements;
+		}
+
+	private:
+		size_t m_count_elements;
+	};
+
+	class Kernel final : public Object<KernelInfo> {
+	private:
+		void setArgRaw(cl_uint index, size_t size, const void * value);
+
+		template <typename T>
+		T getWorkGroupInfo(Device const& device, cl_kernel_work_group_info info_id) const;
+
+		template <typename DataType>
+		void setArgDispatch(cl_uint index, DataType const& value, std::true_type) {
+			const auto mem_id = value.id();
+			setArgRaw(index, sizeof(cl_mem), std::addressof(mem_id));
+		}
+
+		template <typename DataType>
+		void setArgDispatch(cl_uint index, DataType const& value, std::false_type) {
+			static_assert(
+				std::is_trivial<DataType>::value,
+				"kernel arguments have to be memory objects, local memory or of trivial type."
+			);
+			setArgRaw(index, sizeof(DataType), std::addressof(value));
+		}
+
+		void setArgsFrom(cl_uint) {}
+
+		template <typename Arg, typename... Args>
+		void setArgsFrom(cl_uint index, Arg const& arg, Args const&... args) {
+			setArg(index, arg);
+			setArgsFrom(index + 1, args...);
+		}
+
+	public:
+		Kernel(cl_kernel kernel_id);
+		Kernel(Program const& program, std::string const& name);
+
+		template <typename DataType>
+		void setArg(cl_uint index, DataType const& value) {
+			setArgDispatch(index, value, typename std::is_base_of<MemoryObject, DataType>::type{});
+		}
+
+		template <typename DataType>
+		void setArg(cl_uint index, LocalMemory<DataType> const& local) {
+			setArgRaw(index, local.count_elements() * sizeof(DataType), nullptr);
+		}
+
+		void setArg(cl_uint index, Sampler const& sampler);
+
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+		// Pointers into shared virtual memory, e.g. data() of a std::vector with SvmAllocator.
+		template <typename DataType>
+		void setArg(cl_uint index, DataType * svm_pointer) {
+			setArgSvmPointer(index, svm_pointer);
+		}
+
+		void setArgSvmPointer(cl_uint index, const void * svm_pointer);
+
+		// SVM allocations reached only indirectly through pointers stored in other SVM allocations.
+		void setIndirectSvmPointers(std::vector<const void*> const& svm_pointers);
+#endif
+
+		template <typename... Args>
+		void setArgs(Args const&... args) {
+			setArgsFrom(0, args...);
+		}
+
+		std::string functionName() const;
+		cl_uint numArgs() const;
+		cl_uint referenceCount() const;
+		Context context() const;
+		Program program() const;
+
+		size_t workGroupSize(Device const& device) const;
+		size_t preferredWorkGroupSizeMultiple(Device const& device) const;
+		cl_ulong localMemorySize(Device const& device) const;
+		cl_ulong privateMemorySize(Device const& device) const;
+	};
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef CPPCL_LOOKUP_TABLE_HEADER
+#define CPPCL_LOOKUP_TABLE_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "image.hpp"
+#include "kernel.hpp"
+#include "device.hpp"
+#include "cl_type.hpp"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * LookupTable places a read-only table stored in a buffer into the memory
+ * space that serves random reads best on the device of the given queue:
+ *
+ *     image    : the buffer wrapped as an Image1DBuffer (OpenCL 1.2), read
+ *                through the texture cache; chosen if the device supports
+ *                images, the element type has an exact image format and the
+ *                table fits into CL_DEVICE_IMAGE_MAX_BUFFER_SIZE
+ *     constant : the buffer passed as __constant pointer if it fits into
+ *                CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE
+ *     global   : the buffer passed as plain __global pointer otherwise
+ *
+ * Kernels stay agnostic of the choice through the accessor macros defined by
+ * preamble(name), which has to precede the kernel source:
+ *
+ *     __kernel void gather(CPPCL_LOOKUP_TABLE(table), __global uint const* i, __global float* out) {
+ *         out[get_global_id(0)] = CPPCL_LOOKUP(table, i[get_global_id(0)]);
+ *     }
+ *
+ * bind(kernel, index) sets the matching kernel argument. The table is bound
+ * to the device it was created for; build one table per device.
+ */
+
+namespace cl {
+	enum class LookupTableStorage {
+		image,
+		constant,
+		global
+	};
+
+	namespace detail {
+		template <bool Available, ChannelOrder Order, ChannelType Type>
+		struct LookupFormatBase : ImageFormatBase<Order, Type> {
+			static constexpr bool available = Available;
+		};
+
+		template <bool Available, ChannelOrder Order, ChannelType Type>
+		constexpr bool LookupFormatBase<Available, Order, Type>::available;
+
+		// Image formats which return the exact stored values through read_image{f,i,ui}.
+		template <typename DataType>
+		struct LookupFormat : LookupFormatBase<false, ChannelOrder::r, ChannelType::t_float> {};
+
+		template <> struct LookupFormat<cl_char>   final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_signed_int8> {};
+		template <> struct LookupFormat<cl_uchar>  final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_unsigned_int8> {};
+		template <> struct LookupFormat<cl_short>  final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_signed_int16> {};
+		template <> struct LookupFormat<cl_ushort> final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_unsigned_int16> {};
+		template <> struct LookupFormat<cl_int>    final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_signed_int32> {};
+		template <> struct LookupFormat<cl_uint>   final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_unsigned_int32> {};
+		template <> struct LookupFormat<cl_float>  final : LookupFormatBase<true, ChannelOrder::r, ChannelType::t_float> {};
+
+		LookupTableStorage lookupTableStorage(
+			CommandQueue const& queue,
+			size_t count_elements,
+			size_t size_bytes,
+			cl_bool image_format_available,
+			cl_image_format const& format
+		);
+
+		std::string lookupTablePreamble(
+			LookupTableStorage storage,
+			ClTypeInfo const& type,
+			ChannelType channel_type,
+			std::string const& name
+		);
+	}
+
+	template <typename DataType>
+	class LookupTable final {
+	private:
+		using Format = detail::LookupFormat<DataType>;
+
+		Buffer<DataType> m_buffer;
+		LookupTableStorage m_storage;
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		using ImageType = Image1DBuffer<DataType, Format::order, Format::type>;
+
+		std::vector<ImageType> m_image;
+
+		void createImage(Context const& context, std::true_type) {
+			m_image.push_back(ImageType{context, MemoryFlags{CL_MEM_READ_ONLY}, m_buffer});
+		}
+
+		void createImage(Context const&, std::false_type) {}
+#endif
+
+	public:
+		LookupTable(CommandQueue const& queue, Buffer<DataType> const& buffer) :
+			m_buffer{buffer},
+			m_storage{detail::lookupTableStorage(
+				queue, buffer.count_elements(), buffer.size(), Format::available, Format::format())}
+		{
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+			if (m_storage == LookupTableStorage::image) {
+				createImage(queue.context(), std::integral_constant<bool, Format::available>{});
+			}
+#endif
+		}
+
+		LookupTableStorage storage() const {
+			return m_storage;
+		}
+
+		Buffer<DataType> const& buffer() const {
+			return m_buffer;
+		}
+
+		std::string preamble(std::string const& name) const {
+			return detail::lookupTablePreamble(m_storage, ClType<DataType>::info(), Format::type, name);
+		}
+
+		void bind(Kernel & kernel, cl_uint index) const {
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+			if (!m_image.empty()) {
+				kernel.setArg(index, m_image.front());
+				return;
+			}
+#endif
+			kernel.setArg(index, m_buffer);
+		}
+	};
+}
+
+#endif
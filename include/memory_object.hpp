@@ -40,10 +40,8 @@ namespace cl {
 
 	//class MemoryObject : public Object<cl_mem, cl_mem_info, MemoryObjectFunctions, MemoryObjectException> {
 	class MemoryObject : public Object<MemoryObjectInfo> {
-	private:
-		MemoryObject() = delete;
-
 	protected:
+		MemoryObject() = default;
 		using Object::Object;
 
 		template <typename DataType>
@@ -73,7 +71,17 @@ namespace cl {
 		}
 
 		Context context() const {
-			return {getInfo<cl_context>(CL_MEM_CONTEXT)};
+			const auto context_id = getInfo<cl_context>(CL_MEM_CONTEXT);
+			ContextInfo::func_retain(context_id);
+			return {context_id};
+		}
+
+		cl_mem associatedMemoryObjectId() const {
+			return getInfo<cl_mem>(CL_MEM_ASSOCIATED_MEMOBJECT);
+		}
+
+		size_t offsetBytes() const {
+			return getInfo<size_t>(CL_MEM_OFFSET);
 		}
 	};
 }
@@ -0,0 +1,112 @@
+#ifndef CPPCL_ND_RANGE_SPLITTER_HEADER
+#define CPPCL_ND_RANGE_SPLITTER_HEADER
+
+#include "command_queue.hpp"
+#include "kernel.hpp"
+#include "buffer.hpp"
+#include "event.hpp"
+#include "common.hpp"
+
+#include <vector>
+
+/*
+ * NDRangeSplitter distributes one 1-dimensional nd-range over several
+ * command queues of the same context (e.g. sub-devices or heterogeneous devices).
+ *
+ * Slice sizes are proportional to the throughput (work items per nanosecond)
+ * measured through event profiling of previous launches, smoothed by an
+ * exponential moving average. Queues without profiling keep their prior
+ * throughput, which is derived from compute units and clock frequency.
+ *
+ * Every slice is launched with its offset as global work offset so kernels
+ * see absolute indices through get_global_id. Kernels writing into per slice
+ * sub-buffers have to index them with (get_global_id(0) - get_global_offset(0)).
+ */
+
+namespace cl {
+	struct NDRangeSlice final {
+		size_t queue_index;
+		size_t offset;
+		size_t size;
+	};
+
+	class NDRangeSplitter final {
+	private:
+		struct Launch final {
+			size_t queue_index;
+			size_t size;
+			Event event;
+		};
+
+		std::vector<CommandQueue> m_queues;
+		std::vector<cl_bool> m_profiling;
+		std::vector<cl_bool> m_measured;
+		std::vector<double> m_throughput;
+		std::vector<Launch> m_pending;
+		double m_smoothing;
+
+		void record(NDRangeSlice const& slice, Event const& event);
+
+	public:
+		NDRangeSplitter(std::vector<CommandQueue> const& queues, double smoothing = 0.5);
+
+		std::vector<NDRangeSlice> split(size_t global_size, size_t granularity = 1) const;
+
+		void update();
+		void synchronize();
+
+		std::vector<double> throughputs() const;
+		std::vector<CommandQueue> const& queues() const;
+
+		template <typename DataType>
+		size_t subBufferGranularity() const {
+			auto align_bytes = size_t{1};
+			for (auto&& queue : m_queues) {
+				align_bytes = common::lcm(align_bytes, queue.device().memoryBaseAddressAlign() / 8);
+			}
+			return common::lcm(align_bytes, sizeof(DataType)) / sizeof(DataType);
+		}
+
+		template <typename DataType>
+		std::vector<Buffer<DataType>> subBuffers(
+			Buffer<DataType> & buffer,
+			std::vector<NDRangeSlice> const& slices,
+			MemoryFlags const& flags
+		) const {
+			auto sub_buffers = std::vector<Buffer<DataType>>{};
+			for (auto&& slice : slices) {
+				sub_buffers.push_back(buffer.createSubBuffer(flags, slice.offset, slice.size));
+			}
+			return sub_buffers;
+		}
+
+		template <typename SliceBinder>
+		std::vector<Event> enqueue(
+			Kernel & kernel,
+			size_t global_size,
+			size_t local_size,
+			size_t granularity,
+			SliceBinder bind_slice,
+			std::vector<Event> const& events_in_wait_list = {}
+		) {
+			update();
+			const auto unit = common::lcm((local_size > 0) ? local_size : 1, (granularity > 0) ? granularity : 1);
+			auto events = std::vector<Event>{};
+			for (auto&& slice : split(global_size, unit)) {
+				bind_slice(kernel, slice);
+				auto event = m_queues[slice.queue_index].enqueueNDRangeKernel(
+					kernel, slice.offset, slice.size, local_size, events_in_wait_list
+				);
+				record(slice, event);
+				events.push_back(event);
+			}
+			return events;
+		}
+
+		std::vector<Event> enqueue(Kernel & kernel, size_t global_size, size_t local_size = 0) {
+			return enqueue(kernel, global_size, local_size, 1, [](Kernel &, NDRangeSlice const&) {});
+		}
+	};
+}
+
+#endif
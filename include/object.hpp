@@ -33,7 +33,9 @@ namespace cl {
 			return m_id;
 		}
 	protected:
-		Object<ObjectInfo>() {}
+		Object<ObjectInfo>() :
+			m_id{}
+		{}
 
 		Object<ObjectInfo>(typename ObjectInfo::cl_type id) :
 			m_id{id}
@@ -52,17 +54,25 @@ namespace cl {
 		}
 
 		~Object<ObjectInfo>() {
-			ObjectInfo::func_release(m_id);
+			if (m_id != nullptr) ObjectInfo::func_release(m_id);
 		}
 
 		Object<ObjectInfo> & operator=(Object<ObjectInfo> const& other) {
-			m_id = other.id();
-			ObjectInfo::func_retain(m_id);
+			if (this != std::addressof(other)) {
+				if (other.id() != nullptr) ObjectInfo::func_retain(other.id());
+				if (m_id != nullptr) ObjectInfo::func_release(m_id);
+				m_id = other.id();
+			}
+			return * this;
 		}
 
 		Object<ObjectInfo> & operator=(Object<ObjectInfo> && other) {
-			m_id = other.id();
-			ObjectInfo::func_retain(m_id);
+			if (this != std::addressof(other)) {
+				if (other.id() != nullptr) ObjectInfo::func_retain(other.id());
+				if (m_id != nullptr) ObjectInfo::func_release(m_id);
+				m_id = other.id();
+			}
+			return * this;
 		}
 
 		template<typename T>
@@ -0,0 +1,80 @@
+#ifndef CPPCL_PIPE_HEADER
+#define CPPCL_PIPE_HEADER
+
+#include "memory_object.hpp"
+#include "command_queue.hpp"
+#include "kernel.hpp"
+#include "context.hpp"
+#include "event.hpp"
+
+#include <type_traits>
+#include <vector>
+
+/*
+ * Pipe<PacketType> is an OpenCL 2.0 pipe transporting packets of
+ * sizeof(PacketType) bytes between kernels; intermediates of a filter chain
+ * stream through it instead of being materialized in global memory.
+ *
+ *     auto pipe = Pipe<cl_float4>{context, 4096};
+ *     producer.setArgs(input, pipe);    // __kernel void produce(..., __write_only pipe float4 out)
+ *     consumer.setArgs(pipe, output);   // __kernel void consume(__read_only pipe float4 in, ...)
+ *     launchPipeline({{queue_a, producer, n, 0}, {queue_b, consumer, n, 0}});
+ *
+ * Construction checks the packet size and the total capacity against the
+ * limits of every device of the context and throws a MemoryObjectException
+ * with ErrorCode::invalid_pipe_size otherwise.
+ *
+ * Producer and consumer have to run at the same time, so launchPipeline
+ * requires one command queue per stage: on a shared in-order queue the
+ * producer would block forever as soon as the pipe is full.
+ */
+
+namespace cl {
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	namespace detail {
+		cl_mem createPipe(Context const& context, size_t packet_size, cl_uint max_packets);
+		cl_uint pipeInfo(cl_mem pipe, cl_pipe_info info_id);
+	}
+
+	template <typename PacketType>
+	class Pipe final : public MemoryObject {
+	public:
+		static_assert(
+			std::is_trivial<PacketType>::value,
+			"the packet type of a pipe has to be trivial."
+		);
+
+		using packet_type = PacketType;
+
+		Pipe(cl_mem mem) :
+			MemoryObject{mem}
+		{}
+
+		Pipe(Context const& context, cl_uint max_packets) :
+			MemoryObject{detail::createPipe(context, sizeof(PacketType), max_packets)}
+		{}
+
+		cl_uint packetSize() const {
+			return detail::pipeInfo(m_id, CL_PIPE_PACKET_SIZE);
+		}
+
+		cl_uint maxPackets() const {
+			return detail::pipeInfo(m_id, CL_PIPE_MAX_PACKETS);
+		}
+	};
+
+	struct PipeStage final {
+		CommandQueue queue;
+		Kernel kernel;
+		size_t global_size;
+		size_t local_size;
+	};
+
+	// Enqueues all stages without dependencies between them and flushes every queue.
+	std::vector<Event> launchPipeline(
+		std::vector<PipeStage> const& stages,
+		std::vector<Event> const& events_in_wait_list = {});
+#endif
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef CPPCL_PROGRAM_HEADER
+#define CPPCL_PROGRAM_HEADER
+
+#include "object.hpp"
+#include "context.hpp"
+#include "device.hpp"
+#include "error_handler.hpp"
+
+#include <vector>
+#include <string>
+
+namespace cl {
+	class ProgramException;
+
+	struct ProgramInfo final {
+	private:
+		static const error::ErrorMap error_map;
+
+	public:
+		using cl_type = cl_program;
+		using info_type = cl_program_info;
+		using exception_type = ProgramException;
+
+		static decltype(auto) func_release(cl_program id) {
+			error::handle<ProgramException>(clReleaseProgram(id), error_map);
+		}
+
+		static decltype(auto) func_retain(cl_program id) {
+			error::handle<ProgramException>(clRetainProgram(id), error_map);
+		}
+
+		static decltype(auto) func_info
+		(
+			cl_program program,
+			cl_program_info param_name,
+			size_t param_value_size,
+			void *param_value,
+			size_t *param_value_size_ret
+		) {
+			return clGetProgramInfo(
+				program, param_name, param_value_size, param_value, param_value_size_ret);
+		}
+	};
+
+	class Program final : public Object<ProgramInfo> {
+	private:
+		template <typename T>
+		T getBuildInfo(Device const& device, cl_program_build_info info_id) const;
+
+		std::string getBuildInfoString(Device const& device, cl_program_build_info info_id) const;
+
+	public:
+		Program(cl_program program_id);
+		Program(Context const& context, std::string const& source);
+		Program(Context const& context, std::vector<std::string> const& sources);
+
+		void build(std::vector<Device> const& devices, std::string const& options = "");
+		void build(std::string const& options = "");
+
+		BuildStatus buildStatus(Device const& device) const;
+		std::string buildOptions(Device const& device) const;
+		std::string buildLog(Device const& device) const;
+
+		cl_uint referenceCount() const;
+		Context context() const;
+		cl_uint numDevices() const;
+		std::vector<Device> devices() const;
+		std::string source() const;
+	};
+}
+
+#endif
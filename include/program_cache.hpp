@@ -0,0 +1,23 @@
+#ifndef CPPCL_PROGRAM_CACHE_HEADER
+#define CPPCL_PROGRAM_CACHE_HEADER
+
+#include "program.hpp"
+#include "context.hpp"
+
+#include <string>
+
+/*
+ * ProgramCache builds generated program sources once per context
+ * and hands out the built program for every further request of the
+ * same source and build options. It is used by all built-in kernels.
+ */
+
+namespace cl {
+	class ProgramCache final {
+	public:
+		static Program get(Context const& context, std::string const& source, std::string const& options = "");
+		static void clear();
+	};
+}
+
+#endif
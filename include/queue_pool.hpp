@@ -0,0 +1,73 @@
+#ifndef CPPCL_QUEUE_POOL_HEADER
+#define CPPCL_QUEUE_POOL_HEADER
+
+#include "command_queue.hpp"
+#include "command_queue_properties.hpp"
+#include "context.hpp"
+#include "device.hpp"
+#include "event.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/*
+ * QueuePool hands every host thread its own in-order command queue
+ * for a context and device pair, so that submissions of different threads
+ * never contend on a single queue.
+ *
+ * With count_shards == 0 one queue is created lazily per submitting thread.
+ * Otherwise at most count_shards queues are created lazily and threads are
+ * assigned to them round-robin on their first submission.
+ *
+ * The queue of the calling thread is looked up through a thread local cache,
+ * the pool's mutex is only taken when a thread submits for the first time and
+ * by the pool-wide operations.
+ */
+
+namespace cl {
+	class QueuePool final {
+	private:
+		Context m_context;
+		Device m_device;
+		CommandQueueProperties m_properties;
+		size_t m_count_shards;
+		uint64_t m_pool_id;
+
+		mutable std::mutex m_mutex;
+		std::deque<CommandQueue> m_queues;
+		size_t m_next_shard;
+
+		CommandQueue & acquire();
+
+	public:
+		QueuePool(
+			Context const& context,
+			Device const& device,
+			CommandQueueProperties const& properties = CommandQueueProperties{},
+			size_t count_shards = 0
+		);
+
+		~QueuePool();
+
+		QueuePool(QueuePool const&) = delete;
+		QueuePool & operator=(QueuePool const&) = delete;
+
+		CommandQueue & local();
+
+		void flush();
+		void finish();
+
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		std::vector<Event> markers();
+#endif
+
+		size_t size() const;
+		Context const& context() const;
+		Device const& device() const;
+	};
+}
+
+#endif
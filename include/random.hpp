@@ -0,0 +1,114 @@
+#ifndef CPPCL_RANDOM_HEADER
+#define CPPCL_RANDOM_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Counter-based random number generation directly into buffers.
+ *
+ * Numbers come from Philox4x32-10: element e of a buffer filled with
+ * (seed, stream_offset) is derived from counter (stream_offset + e) and key
+ * seed only, so any range of any stream can be regenerated independently and
+ * work items share no state. Filling a buffer in two parts with consecutive
+ * offsets yields the same numbers as filling it at once.
+ *
+ * Distributions:
+ *     uniform(lower, upper)  : floating point in [lower, upper)
+ *     normal(mean, stddev)   : floating point through Box-Muller
+ *     integer(lower, upper)  : integers in [lower, upper], bounds kept exactly
+ *
+ * Floating point distributions require a floating point buffer and integer
+ * distributions an integer buffer; mismatches throw a KernelException.
+ */
+
+namespace cl {
+	enum class RandomDistributionType {
+		uniform,
+		normal,
+		integer
+	};
+
+	class RandomDistribution final {
+	private:
+		RandomDistributionType m_type;
+		double m_first;
+		double m_second;
+		cl_ulong m_integer_lower;
+		cl_ulong m_integer_upper;
+
+		RandomDistribution(
+			RandomDistributionType type, double first, double second, cl_ulong integer_lower, cl_ulong integer_upper);
+
+	public:
+		static RandomDistribution uniform(double lower = 0.0, double upper = 1.0);
+		static RandomDistribution normal(double mean = 0.0, double stddev = 1.0);
+
+		// Bounds are kept exactly as two's complement bit patterns; a double would round 64-bit bounds.
+		template <typename IntegerType>
+		static RandomDistribution integer(IntegerType lower, IntegerType upper) {
+			static_assert(
+				std::is_integral<IntegerType>::value,
+				"the bounds of an integer distribution have to be integers."
+			);
+			return {
+				RandomDistributionType::integer,
+				static_cast<double>(lower), static_cast<double>(upper),
+				static_cast<cl_ulong>(lower), static_cast<cl_ulong>(upper)
+			};
+		}
+
+		RandomDistributionType type() const;
+		double first() const;
+		double second() const;
+		cl_ulong integerLower() const;
+		cl_ulong integerUpper() const;
+	};
+
+	namespace detail {
+		std::string randomSource(ClTypeInfo const& type, size_t type_size, RandomDistributionType distribution);
+		void requireDistributionType(ClTypeInfo const& type, RandomDistributionType distribution);
+	}
+
+	template <typename DataType>
+	Event generateRandom(
+		CommandQueue & queue,
+		Buffer<DataType> const& buffer,
+		RandomDistribution const& distribution,
+		cl_ulong seed,
+		cl_ulong stream_offset = 0,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		static_assert(
+			sizeof(DataType) == 4 || sizeof(DataType) == 8,
+			"random numbers can only be generated for 32-bit and 64-bit types."
+		);
+		const auto info = ClType<DataType>::info();
+		detail::requireDistributionType(info, distribution.type());
+		detail::requireFloatingPoint(queue.device(), info.scalar);
+		const auto program = ProgramCache::get(
+			queue.context(), detail::randomSource(info, sizeof(DataType), distribution.type()));
+		auto kernel = Kernel{program, "cppcl_generate_random"};
+		const auto count = buffer.count_elements();
+		const auto per_block = cl_ulong{16 / sizeof(DataType)};
+		const auto first_block = stream_offset / per_block;
+		const auto last_block = (stream_offset + count - 1) / per_block;
+		const auto is_integer = distribution.type() == RandomDistributionType::integer;
+		kernel.setArgs(
+			buffer, cl_ulong{count}, seed, stream_offset, first_block,
+			(is_integer) ? static_cast<DataType>(distribution.integerLower()) : static_cast<DataType>(distribution.first()),
+			(is_integer) ? static_cast<DataType>(distribution.integerUpper()) : static_cast<DataType>(distribution.second())
+		);
+		return queue.enqueueNDRangeKernel(kernel, 0, last_block - first_block + 1, 0, events_in_wait_list);
+	}
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef CPPCL_REDUCE_HEADER
+#define CPPCL_REDUCE_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * Device-side reduction of a Buffer<DataType> into a one-element buffer.
+ *
+ * Every pass launches work-groups that accumulate a grid-strided part of the
+ * input in private memory and combine it in a local memory tree. The
+ * work-group size is bounded by Device::maxWorkGroupSize() and
+ * Device::localMemorySize(), the number of work-groups by the work-group size,
+ * so at most two passes are required.
+ *
+ * A ReduceOperator consists of OpenCL C expressions for its identity and for
+ * combining two values a and b of type T. Identities may refer to T_MAX and
+ * T_LOWEST. Operators have to be associative and commutative.
+ */
+
+namespace cl {
+	class ReduceOperator final {
+	public:
+		ReduceOperator(std::string identity, std::string combine);
+
+		static ReduceOperator sum();
+		static ReduceOperator product();
+		static ReduceOperator minimum();
+		static ReduceOperator maximum();
+		static ReduceOperator bitAnd();
+		static ReduceOperator bitOr();
+		static ReduceOperator bitXor();
+
+		std::string const& identity() const;
+		std::string const& combine() const;
+
+	private:
+		std::string m_identity;
+		std::string m_combine;
+	};
+
+	template <typename DataType>
+	struct ReduceResult final {
+		Buffer<DataType> result;
+		Event event;
+	};
+
+	template <typename DataType>
+	struct ArgReduceResult final {
+		Buffer<DataType> value;
+		Buffer<cl_ulong> index;
+		Event event;
+	};
+
+	namespace detail {
+		std::string operatorPreamble(ReduceOperator const& op);
+		std::string reduceSource(ClTypeInfo const& type, ReduceOperator const& op);
+		std::string argReduceSource(ClTypeInfo const& type, cl_bool maximum);
+		// Largest power of two work-group size whose local memory fits; 0 if not even one work item fits.
+		size_t fittingWorkGroupSize(Device const& device, Kernel const& kernel, size_t bytes_per_item);
+		// Like fittingWorkGroupSize but throws a DeviceException if not even one work item fits.
+		size_t reduceWorkGroupSize(Device const& device, Kernel const& kernel, size_t bytes_per_item);
+
+		template <typename DataType>
+		ArgReduceResult<DataType> argReduce(
+			CommandQueue & queue,
+			Buffer<DataType> const& input,
+			cl_bool maximum,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			const auto device = queue.device();
+			requireFloatingPoint(device, ClType<DataType>::info().scalar);
+			const auto program = ProgramCache::get(context, argReduceSource(ClType<DataType>::info(), maximum));
+			auto kernel = Kernel{program, "cppcl_arg_reduce"};
+			const auto local_size = reduceWorkGroupSize(device, kernel, sizeof(DataType) + sizeof(cl_ulong));
+			const auto flags = MemoryFlags{}.readWrite(true);
+			auto values = input;
+			auto indices = Buffer<cl_ulong>{context, flags, 1};
+			auto has_indices = cl_uint{0};
+			auto count = input.count_elements();
+			auto events = events_in_wait_list;
+			while (true) {
+				const auto groups = std::max(std::min((count + local_size - 1) / local_size, local_size), size_t{1});
+				auto out_values = Buffer<DataType>{context, flags, groups};
+				auto out_indices = Buffer<cl_ulong>{context, flags, groups};
+				kernel.setArgs(
+					values, indices, has_indices, cl_ulong{count}, out_values, out_indices,
+					LocalMemory<DataType>{local_size}, LocalMemory<cl_ulong>{local_size}
+				);
+				auto event = queue.enqueueNDRangeKernel(kernel, 0, groups * local_size, local_size, events);
+				if (groups == 1) return {out_values, out_indices, event};
+				values = out_values;
+				indices = out_indices;
+				has_indices = 1;
+				count = groups;
+				events = std::vector<Event>{event};
+			}
+		}
+	}
+
+	template <typename DataType>
+	ReduceResult<DataType> reduce(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		ReduceOperator const& op,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		const auto context = queue.context();
+		const auto device = queue.device();
+		detail::requireFloatingPoint(device, ClType<DataType>::info().scalar);
+		const auto program = ProgramCache::get(context, detail::reduceSource(ClType<DataType>::info(), op));
+		auto kernel = Kernel{program, "cppcl_reduce"};
+		const auto local_size = detail::reduceWorkGroupSize(device, kernel, sizeof(DataType));
+		auto source = input;
+		auto count = input.count_elements();
+		auto events = events_in_wait_list;
+		while (true) {
+			const auto groups = std::max(std::min((count + local_size - 1) / local_size, local_size), size_t{1});
+			auto output = Buffer<DataType>{context, MemoryFlags{}.readWrite(true), groups};
+			kernel.setArgs(source, cl_ulong{count}, output, LocalMemory<DataType>{local_size});
+			auto event = queue.enqueueNDRangeKernel(kernel, 0, groups * local_size, local_size, events);
+			if (groups == 1) return {output, event};
+			source = output;
+			count = groups;
+			events = std::vector<Event>{event};
+		}
+	}
+
+	template <typename DataType>
+	ArgReduceResult<DataType> argmin(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::argReduce(queue, input, false, events_in_wait_list);
+	}
+
+	template <typename DataType>
+	ArgReduceResult<DataType> argmax(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::argReduce(queue, input, true, events_in_wait_list);
+	}
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef CPPCL_RESAMPLE_HEADER
+#define CPPCL_RESAMPLE_HEADER
+
+#include "command_queue.hpp"
+#include "image.hpp"
+#include "memory_object.hpp"
+#include "event.hpp"
+
+#include <array>
+#include <cassert>
+#include <vector>
+
+/*
+ * Image resampling through the texture units: all kernels read their source
+ * with a linear filtering sampler (taken from the SamplerCache), so bilinear
+ * interpolation is done by the runtime instead of four loads and a blend.
+ *
+ *     resize      : scales the source to the extent of the destination
+ *     warp        : projective warp; transform is a row-major 3x3 matrix
+ *                   mapping destination pixel coordinates to source pixel
+ *                   coordinates (pixel centers at +0.5), samples outside of
+ *                   the source read the border color
+ *     pyramidDown : halves the source with a 4x4 binomial filter made of
+ *                   four bilinear taps; destination extent ((w + 1) / 2, (h + 1) / 2)
+ *
+ * Source and destination formats have to be readable through read_imagef
+ * and writable through write_imagef, i.e. floating point or normalized.
+ */
+
+namespace cl {
+	namespace detail {
+		constexpr bool isFilterableChannelType(ChannelType type) {
+			return type != ChannelType::t_signed_int8
+				&& type != ChannelType::t_signed_int16
+				&& type != ChannelType::t_signed_int32
+				&& type != ChannelType::t_unsigned_int8
+				&& type != ChannelType::t_unsigned_int16
+				&& type != ChannelType::t_unsigned_int32;
+		}
+
+		Event resizeImage(
+			CommandQueue & queue,
+			MemoryObject const& src,
+			MemoryObject const& dst,
+			std::array<size_t, 2> const& dst_extent,
+			std::vector<Event> const& events_in_wait_list
+		);
+
+		Event warpImage(
+			CommandQueue & queue,
+			MemoryObject const& src,
+			MemoryObject const& dst,
+			std::array<size_t, 2> const& dst_extent,
+			std::array<float, 9> const& transform,
+			std::vector<Event> const& events_in_wait_list
+		);
+
+		Event pyramidDownImage(
+			CommandQueue & queue,
+			MemoryObject const& src,
+			MemoryObject const& dst,
+			std::array<size_t, 2> const& dst_extent,
+			std::vector<Event> const& events_in_wait_list
+		);
+	}
+
+	template <
+		typename SrcPixel, ChannelOrder SrcOrder, ChannelType SrcType,
+		typename DstPixel, ChannelOrder DstOrder, ChannelType DstType
+	>
+	Event resize(
+		CommandQueue & queue,
+		Image2D<SrcPixel, SrcOrder, SrcType> const& src,
+		Image2D<DstPixel, DstOrder, DstType> const& dst,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		static_assert(
+			detail::isFilterableChannelType(SrcType) && detail::isFilterableChannelType(DstType),
+			"resampling requires floating point or normalized image formats."
+		);
+		return detail::resizeImage(queue, src, dst, {{dst.width(), dst.height()}}, events_in_wait_list);
+	}
+
+	template <
+		typename SrcPixel, ChannelOrder SrcOrder, ChannelType SrcType,
+		typename DstPixel, ChannelOrder DstOrder, ChannelType DstType
+	>
+	Event warp(
+		CommandQueue & queue,
+		Image2D<SrcPixel, SrcOrder, SrcType> const& src,
+		Image2D<DstPixel, DstOrder, DstType> const& dst,
+		std::array<float, 9> const& transform,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		static_assert(
+			detail::isFilterableChannelType(SrcType) && detail::isFilterableChannelType(DstType),
+			"resampling requires floating point or normalized image formats."
+		);
+		return detail::warpImage(queue, src, dst, {{dst.width(), dst.height()}}, transform, events_in_wait_list);
+	}
+
+	template <
+		typename SrcPixel, ChannelOrder SrcOrder, ChannelType SrcType,
+		typename DstPixel, ChannelOrder DstOrder, ChannelType DstType
+	>
+	Event pyramidDown(
+		CommandQueue & queue,
+		Image2D<SrcPixel, SrcOrder, SrcType> const& src,
+		Image2D<DstPixel, DstOrder, DstType> const& dst,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		static_assert(
+			detail::isFilterableChannelType(SrcType) && detail::isFilterableChannelType(DstType),
+			"resampling requires floating point or normalized image formats."
+		);
+		const auto extent = std::array<size_t, 2>{{dst.width(), dst.height()}};
+		assert(extent[0] == (src.width() + 1) / 2 && extent[1] == (src.height() + 1) / 2);
+		return detail::pyramidDownImage(queue, src, dst, extent, events_in_wait_list);
+	}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef CPPCL_RESIDENCY_MANAGER_HEADER
+#define CPPCL_RESIDENCY_MANAGER_HEADER
+
+#include "command_queue.hpp"
+#include "memory_object.hpp"
+#include "event.hpp"
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/*
+ * ResidencyManager tracks the device that last touched every memory object
+ * and migrates memory objects to the device of a command queue before a
+ * command runs there, instead of leaving the migration to the implicit
+ * transfer at launch time.
+ *
+ *     ResidencyManager residency;
+ *     auto a = residency.launch(queue_gpu0, {input}, {temp}, launchFirst);
+ *     auto b = residency.launch(queue_gpu1, {temp}, {output}, launchSecond, {a});
+ *
+ * Inputs are migrated with their content, outputs with
+ * CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED; memory objects appearing in both
+ * lists count as inputs. prefetch() enqueues migrations early so they can
+ * overlap with the commands still running on the previous device.
+ *
+ * Memory objects are tracked by handle and not retained; forget() them
+ * before releasing them when the manager outlives them.
+ */
+
+namespace cl {
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+	class ResidencyManager final {
+	public:
+		using Command = std::function<Event(CommandQueue &, std::vector<Event> const&)>;
+
+	private:
+		mutable std::mutex m_mutex;
+		std::map<cl_mem, cl_device_id> m_location;
+
+	public:
+		ResidencyManager();
+
+		// Returns the migration events, which commands using the memory objects have to wait for.
+		std::vector<Event> prefetch(
+			CommandQueue & queue,
+			std::vector<MemoryObject> const& inputs,
+			std::vector<MemoryObject> const& outputs = {},
+			std::vector<Event> const& events_in_wait_list = {});
+
+		void record(
+			CommandQueue const& queue,
+			std::vector<MemoryObject> const& memory_objects);
+
+		Event launch(
+			CommandQueue & queue,
+			std::vector<MemoryObject> const& inputs,
+			std::vector<MemoryObject> const& outputs,
+			Command const& command,
+			std::vector<Event> const& events_in_wait_list = {});
+
+		cl_bool isResidentOn(MemoryObject const& memory_object, Device const& device) const;
+		void forget(MemoryObject const& memory_object);
+		void clear();
+	};
+#endif
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef CPPCL_SAMPLER_HEADER
+#define CPPCL_SAMPLER_HEADER
+
+#include "object.hpp"
+#include "context.hpp"
+#include "error_handler.hpp"
+
+/*
+ * Sampler wraps cl_sampler objects which describe how kernels read images
+ * through read_image{f,i,ui}: coordinate normalization, addressing at the
+ * image borders and nearest or linear (hardware bilinear) filtering.
+ *
+ * SamplerCache hands out one shared sampler per context and configuration,
+ * so built-in kernels do not create a new sampler on every launch.
+ */
+
+namespace cl {
+	class SamplerException;
+
+	struct SamplerInfo final {
+	private:
+		static const error::ErrorMap error_map;
+
+	public:
+		using cl_type = cl_sampler;
+		using info_type = cl_sampler_info;
+		using exception_type = SamplerException;
+
+		static decltype(auto) func_release(cl_sampler id) {
+			error::handle<SamplerException>(clReleaseSampler(id), error_map);
+		}
+
+		static decltype(auto) func_retain(cl_sampler id) {
+			error::handle<SamplerException>(clRetainSampler(id), error_map);
+		}
+
+		static decltype(auto) func_info
+		(
+			cl_sampler sampler,
+			cl_sampler_info param_name,
+			size_t param_value_size,
+			void *param_value,
+			size_t *param_value_size_ret
+		) {
+			return clGetSamplerInfo(
+				sampler, param_name, param_value_size, param_value, param_value_size_ret);
+		}
+	};
+
+	class Sampler final : public Object<SamplerInfo> {
+	public:
+		Sampler(cl_sampler sampler_id);
+		Sampler(
+			Context const& context,
+			cl_bool normalized_coordinates,
+			AddressingMode addressing_mode,
+			FilterMode filter_mode
+		);
+
+		cl_uint referenceCount() const;
+		Context context() const;
+		cl_bool normalizedCoordinates() const;
+		AddressingMode addressingMode() const;
+		FilterMode filterMode() const;
+	};
+
+	class SamplerCache final {
+	public:
+		static Sampler get(
+			Context const& context,
+			cl_bool normalized_coordinates,
+			AddressingMode addressing_mode,
+			FilterMode filter_mode
+		);
+		static void clear();
+	};
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef CPPCL_SCAN_HEADER
+#define CPPCL_SCAN_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "reduce.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <vector>
+
+/*
+ * Device-side prefix scan and stream compaction.
+ *
+ * Scans follow the block-scan-then-propagate scheme: every work-group scans a
+ * block of two elements per work item in local memory (work-efficient up- and
+ * down-sweep) and emits the block total, the block totals are scanned
+ * recursively and finally added to every element of their block.
+ * Operators only have to be associative.
+ *
+ * copyIf and partition evaluate a predicate given as OpenCL C expression of
+ * the element x, scan the resulting flags and scatter the elements. Both are
+ * stable and leave the number of selected elements on the device.
+ *
+ * reduceByKey reduces runs of equal keys (e.g. of sorted keys) through a
+ * segmented inclusive scan whose segments start at key changes and gathers
+ * the last element of every run. The number of runs stays on the device.
+ */
+
+namespace cl {
+	struct CompactResult final {
+		Buffer<cl_uint> count;
+		Event event;
+	};
+
+	namespace detail {
+		std::string scanSource(ClTypeInfo const& type, ReduceOperator const& op);
+		std::string compactSource(ClTypeInfo const& type, std::string const& predicate);
+		std::string segmentedScanSource(ClTypeInfo const& type, ReduceOperator const& op);
+		std::string reduceByKeySource(ClTypeInfo const& key, ClTypeInfo const& value);
+
+		template <typename DataType>
+		Event scan(
+			CommandQueue & queue,
+			Buffer<DataType> const& input,
+			Buffer<DataType> const& output,
+			size_t count,
+			ReduceOperator const& op,
+			cl_bool inclusive,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+			const auto program = ProgramCache::get(context, scanSource(ClType<DataType>::info(), op));
+			auto scan_blocks = Kernel{program, "cppcl_scan_blocks"};
+			const auto local_size = reduceWorkGroupSize(queue.device(), scan_blocks, 2 * sizeof(DataType));
+			const auto block_size = 2 * local_size;
+			const auto groups = std::max((count + block_size - 1) / block_size, size_t{1});
+			auto block_sums = Buffer<DataType>{context, MemoryFlags{}.readWrite(true), groups};
+			scan_blocks.setArgs(
+				input, output, block_sums, cl_ulong{count}, cl_uint{inclusive},
+				LocalMemory<DataType>{block_size}
+			);
+			auto event = queue.enqueueNDRangeKernel(
+				scan_blocks, 0, groups * local_size, local_size, events_in_wait_list);
+			if (groups == 1) return event;
+			event = scan(queue, block_sums, block_sums, groups, op, false, std::vector<Event>{event});
+			auto add_offsets = Kernel{program, "cppcl_scan_add"};
+			add_offsets.setArgs(output, block_sums, cl_ulong{count}, cl_ulong{block_size});
+			return queue.enqueueNDRangeKernel(add_offsets, 0, count, 0, std::vector<Event>{event});
+		}
+
+		template <typename DataType>
+		Event segmentedScan(
+			CommandQueue & queue,
+			Buffer<DataType> const& input,
+			Buffer<cl_uint> const& heads,
+			Buffer<DataType> const& output,
+			size_t count,
+			ReduceOperator const& op,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+			const auto program = ProgramCache::get(context, segmentedScanSource(ClType<DataType>::info(), op));
+			auto scan_blocks = Kernel{program, "cppcl_segmented_scan_blocks"};
+			const auto block_size = reduceWorkGroupSize(queue.device(), scan_blocks, sizeof(DataType) + sizeof(cl_uint));
+			// Blocks of one element never shrink the recursion; scan in a single work item instead.
+			if (block_size < 2) {
+				auto scan_serial = Kernel{program, "cppcl_segmented_scan_serial"};
+				scan_serial.setArgs(input, heads, output, cl_ulong{count});
+				return queue.enqueueNDRangeKernel(scan_serial, 0, 1, 1, events_in_wait_list);
+			}
+			const auto groups = std::max((count + block_size - 1) / block_size, size_t{1});
+			const auto flags = MemoryFlags{}.readWrite(true);
+			auto block_values = Buffer<DataType>{context, flags, groups};
+			auto block_heads = Buffer<cl_uint>{context, flags, groups};
+			auto block_first_head = Buffer<cl_uint>{context, flags, groups};
+			scan_blocks.setArgs(
+				input, heads, output, block_values, block_heads, block_first_head, cl_ulong{count},
+				LocalMemory<DataType>{block_size}, LocalMemory<cl_uint>{block_size}
+			);
+			auto event = queue.enqueueNDRangeKernel(
+				scan_blocks, 0, groups * block_size, block_size, events_in_wait_list);
+			if (groups == 1) return event;
+			event = segmentedScan(
+				queue, block_values, block_heads, block_values, groups, op, std::vector<Event>{event});
+			auto add_carries = Kernel{program, "cppcl_segmented_scan_add"};
+			add_carries.setArgs(output, block_values, block_first_head, cl_ulong{count}, cl_ulong{block_size});
+			return queue.enqueueNDRangeKernel(add_carries, 0, count, 0, std::vector<Event>{event});
+		}
+
+		template <typename DataType>
+		CompactResult compact(
+			CommandQueue & queue,
+			Buffer<DataType> const& input,
+			Buffer<DataType> const& output,
+			std::string const& predicate,
+			cl_bool partition,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			const auto flags = MemoryFlags{}.readWrite(true);
+			const auto count = input.count_elements();
+			auto result = Buffer<cl_uint>{context, flags, 1};
+			requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+			const auto program = ProgramCache::get(context, compactSource(ClType<DataType>::info(), predicate));
+			auto flag = Kernel{program, "cppcl_flag"};
+			auto scatter = Kernel{program, "cppcl_scatter"};
+			auto selected = Buffer<cl_uint>{context, flags, count};
+			auto positions = Buffer<cl_uint>{context, flags, count};
+			flag.setArgs(input, selected, cl_ulong{count});
+			auto event = queue.enqueueNDRangeKernel(flag, 0, count, 0, events_in_wait_list);
+			event = scan(queue, selected, positions, count, ReduceOperator::sum(), false, std::vector<Event>{event});
+			scatter.setArgs(input, selected, positions, cl_ulong{count}, output, result, cl_uint{partition});
+			event = queue.enqueueNDRangeKernel(scatter, 0, count, 0, std::vector<Event>{event});
+			return {result, event};
+		}
+	}
+
+	template <typename DataType>
+	Event inclusiveScan(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<DataType> const& output,
+		ReduceOperator const& op = ReduceOperator::sum(),
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::scan(queue, input, output, input.count_elements(), op, true, events_in_wait_list);
+	}
+
+	template <typename DataType>
+	Event exclusiveScan(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<DataType> const& output,
+		ReduceOperator const& op = ReduceOperator::sum(),
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::scan(queue, input, output, input.count_elements(), op, false, events_in_wait_list);
+	}
+
+	template <typename DataType>
+	CompactResult copyIf(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<DataType> const& output,
+		std::string const& predicate,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::compact(queue, input, output, predicate, false, events_in_wait_list);
+	}
+
+	template <typename DataType>
+	CompactResult partition(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<DataType> const& output,
+		std::string const& predicate,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::compact(queue, input, output, predicate, true, events_in_wait_list);
+	}
+
+	template <typename KeyType, typename ValueType>
+	CompactResult reduceByKey(
+		CommandQueue & queue,
+		Buffer<KeyType> const& keys,
+		Buffer<ValueType> const& values,
+		Buffer<KeyType> const& keys_output,
+		Buffer<ValueType> const& values_output,
+		ReduceOperator const& op = ReduceOperator::sum(),
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		const auto context = queue.context();
+		const auto flags = MemoryFlags{}.readWrite(true);
+		const auto count = keys.count_elements();
+		assert(values.count_elements() >= count);
+		detail::requireFloatingPoint(queue.device(), ClType<KeyType>::info().scalar);
+		detail::requireFloatingPoint(queue.device(), ClType<ValueType>::info().scalar);
+		const auto program = ProgramCache::get(
+			context, detail::reduceByKeySource(ClType<KeyType>::info(), ClType<ValueType>::info()));
+		auto mark_heads = Kernel{program, "cppcl_segment_heads"};
+		auto scatter = Kernel{program, "cppcl_reduce_by_key_scatter"};
+		auto heads = Buffer<cl_uint>{context, flags, count};
+		auto positions = Buffer<cl_uint>{context, flags, count};
+		auto reduced = Buffer<ValueType>{context, flags, count};
+		auto result = Buffer<cl_uint>{context, flags, 1};
+		mark_heads.setArgs(keys, heads, cl_ulong{count});
+		const auto heads_event = queue.enqueueNDRangeKernel(mark_heads, 0, count, 0, events_in_wait_list);
+		const auto wait = std::vector<Event>{heads_event};
+		const auto scan_event = detail::segmentedScan(queue, values, heads, reduced, count, op, wait);
+		const auto positions_event = detail::scan(
+			queue, heads, positions, count, ReduceOperator::sum(), false, wait);
+		scatter.setArgs(
+			keys, heads, positions, reduced, cl_ulong{count}, keys_output, values_output, result);
+		const auto event = queue.enqueueNDRangeKernel(
+			scatter, 0, count, 0, std::vector<Event>{scan_event, positions_event});
+		return {result, event};
+	}
+}
+
+#endif
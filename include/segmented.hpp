@@ -0,0 +1,131 @@
+#ifndef CPPCL_SEGMENTED_HEADER
+#define CPPCL_SEGMENTED_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "reduce.hpp"
+#include "scan.hpp"
+#include "sort.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+/*
+ * Segmented reduce, scan and sort.
+ *
+ * Segments are given like CSR row offsets: segment s spans the elements
+ * [offsets[s], offsets[s + 1]), offsets[0] is 0 and the last offset is the
+ * number of elements. Segments may be empty.
+ *
+ * segmentedReduce uses one work-group per segment and writes IDENTITY for
+ * empty segments. Scans restart at every segment through the segmented scan
+ * of reduceByKey. segmentedSort stably sorts all keys carrying their segment
+ * ids and then stably sorts by segment id, which orders every segment by key.
+ */
+
+namespace cl {
+	namespace detail {
+		std::string segmentSource();
+		std::string segmentedSource(ClTypeInfo const& type, ReduceOperator const& op);
+
+		inline Event segmentIds(
+			CommandQueue & queue,
+			Buffer<cl_uint> const& offsets,
+			size_t count,
+			Buffer<cl_uint> const& ids,
+			Buffer<cl_uint> const& heads,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			auto kernel = Kernel{ProgramCache::get(queue.context(), segmentSource()), "cppcl_segment_ids"};
+			kernel.setArgs(offsets, cl_uint(offsets.count_elements() - 1), cl_ulong{count}, ids, heads);
+			return queue.enqueueNDRangeKernel(kernel, 0, count, 0, events_in_wait_list);
+		}
+	}
+
+	template <typename DataType>
+	Event segmentedReduce(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<cl_uint> const& offsets,
+		Buffer<DataType> const& output,
+		ReduceOperator const& op,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		const auto segments = offsets.count_elements() - 1;
+		assert(output.count_elements() >= segments);
+		detail::requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+		const auto program = ProgramCache::get(
+			queue.context(), detail::segmentedSource(ClType<DataType>::info(), op));
+		auto kernel = Kernel{program, "cppcl_segmented_reduce"};
+		const auto local_size = detail::reduceWorkGroupSize(queue.device(), kernel, sizeof(DataType));
+		kernel.setArgs(input, offsets, output, LocalMemory<DataType>{local_size});
+		return queue.enqueueNDRangeKernel(kernel, 0, segments * local_size, local_size, events_in_wait_list);
+	}
+
+	template <typename DataType>
+	Event segmentedInclusiveScan(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<cl_uint> const& offsets,
+		Buffer<DataType> const& output,
+		ReduceOperator const& op = ReduceOperator::sum(),
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		detail::requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+		const auto context = queue.context();
+		const auto count = input.count_elements();
+		const auto flags = MemoryFlags{}.readWrite(true);
+		auto ids = Buffer<cl_uint>{context, flags, count};
+		auto heads = Buffer<cl_uint>{context, flags, count};
+		const auto event = detail::segmentIds(queue, offsets, count, ids, heads, events_in_wait_list);
+		return detail::segmentedScan(queue, input, heads, output, count, op, std::vector<Event>{event});
+	}
+
+	template <typename DataType>
+	Event segmentedExclusiveScan(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<cl_uint> const& offsets,
+		Buffer<DataType> const& output,
+		ReduceOperator const& op = ReduceOperator::sum(),
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		detail::requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+		const auto context = queue.context();
+		const auto count = input.count_elements();
+		const auto flags = MemoryFlags{}.readWrite(true);
+		auto ids = Buffer<cl_uint>{context, flags, count};
+		auto heads = Buffer<cl_uint>{context, flags, count};
+		auto inclusive = Buffer<DataType>{context, flags, count};
+		auto event = detail::segmentIds(queue, offsets, count, ids, heads, events_in_wait_list);
+		event = detail::segmentedScan(queue, input, heads, inclusive, count, op, std::vector<Event>{event});
+		const auto program = ProgramCache::get(context, detail::segmentedSource(ClType<DataType>::info(), op));
+		auto shift = Kernel{program, "cppcl_segmented_shift"};
+		shift.setArgs(inclusive, heads, output, cl_ulong{count});
+		return queue.enqueueNDRangeKernel(shift, 0, count, 0, std::vector<Event>{event});
+	}
+
+	template <typename KeyType>
+	Event segmentedSort(
+		CommandQueue & queue,
+		Buffer<KeyType> const& keys,
+		Buffer<cl_uint> const& offsets,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		const auto context = queue.context();
+		const auto count = keys.count_elements();
+		const auto flags = MemoryFlags{}.readWrite(true);
+		auto ids = Buffer<cl_uint>{context, flags, count};
+		auto heads = Buffer<cl_uint>{context, flags, count};
+		auto event = detail::segmentIds(queue, offsets, count, ids, heads, events_in_wait_list);
+		event = sortByKey(queue, keys, ids, std::vector<Event>{event});
+		return sortByKey(queue, ids, keys, std::vector<Event>{event});
+	}
+}
+
+#endif
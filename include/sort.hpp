@@ -0,0 +1,153 @@
+#ifndef CPPCL_SORT_HEADER
+#define CPPCL_SORT_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "reduce.hpp"
+#include "scan.hpp"
+#include "exception.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * In-place ascending device sort for 32-bit and 64-bit integer and floating point keys.
+ *
+ * Keys are mapped to unsigned integers of equal width whose order matches
+ * the order of the keys (sign bit flipped for signed integers, all bits
+ * flipped for negative floating point numbers) and sorted by a stable LSD
+ * radix sort over digits of RADIX_BITS bits. Every pass counts digits per
+ * work-group in a local-memory histogram, scans all histograms in digit-major
+ * order and scatters every work-group's tile after ranking it locally through
+ * successive 1-bit splits. The radix sort needs work-groups of at least
+ * RADIX work items; devices that cannot provide them throw a DeviceException.
+ *
+ * Inputs fitting into the local memory of one work-group are sorted by a
+ * single work-group bitonic network instead. It compares (key, index) pairs
+ * so that it is stable just like the radix sort.
+ */
+
+namespace cl {
+	namespace detail {
+		std::string sortSource(ClTypeInfo const& key, std::string const& bits_type, ClTypeInfo const* value);
+
+		template <typename KeyType, typename ValueType>
+		Event sort(
+			CommandQueue & queue,
+			Buffer<KeyType> const& keys,
+			Buffer<ValueType> const* values,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			static_assert(
+				std::is_arithmetic<KeyType>::value && (sizeof(KeyType) == 4 || sizeof(KeyType) == 8),
+				"sort keys have to be 32-bit or 64-bit integer or floating point types."
+			);
+			using BitsType = typename std::conditional<sizeof(KeyType) == 4, cl_uint, cl_ulong>::type;
+			constexpr auto radix_bits = cl_uint{4};
+			constexpr auto radix = size_t{1} << radix_bits;
+
+			const auto count = keys.count_elements();
+			if (values != nullptr) assert(values->count_elements() == count);
+
+			const auto context = queue.context();
+			const auto device = queue.device();
+			const auto value_info = ClType<ValueType>::info();
+			requireFloatingPoint(device, ClType<KeyType>::info().scalar);
+			if (values) requireFloatingPoint(device, value_info.scalar);
+			const auto program = ProgramCache::get(
+				context,
+				sortSource(ClType<KeyType>::info(), ClType<BitsType>::info().name, (values) ? &value_info : nullptr)
+			);
+			const auto value_size = (values) ? sizeof(ValueType) : 0;
+
+			auto bitonic = Kernel{program, "cppcl_bitonic_sort"};
+			const auto bitonic_bytes = sizeof(BitsType) + sizeof(cl_uint) + sizeof(KeyType) + value_size;
+			const auto bitonic_local = reduceWorkGroupSize(device, bitonic, 4 * bitonic_bytes);
+			if (count <= 4 * bitonic_local) {
+				auto size = size_t{1};
+				while (size < count) size *= 2;
+				const auto local_size = std::max(std::min(bitonic_local, size / 2), size_t{1});
+				bitonic.setArgs(
+					keys, cl_ulong{count}, static_cast<cl_uint>(size),
+					LocalMemory<BitsType>{size}, LocalMemory<cl_uint>{size}, LocalMemory<KeyType>{size}
+				);
+				if (values) {
+					bitonic.setArg(6, *values);
+					bitonic.setArg(7, LocalMemory<ValueType>{size});
+				}
+				return queue.enqueueNDRangeKernel(bitonic, 0, local_size, local_size, events_in_wait_list);
+			}
+
+			auto radix_count = Kernel{program, "cppcl_radix_count"};
+			auto radix_scatter = Kernel{program, "cppcl_radix_scatter"};
+			const auto local_size = std::min(
+				reduceWorkGroupSize(device, radix_count, sizeof(cl_uint)),
+				reduceWorkGroupSize(device, radix_scatter, sizeof(BitsType) + 2 * sizeof(cl_uint))
+			);
+			// The radix kernels clear and read one histogram bucket per work item.
+			if (local_size < radix) {
+				throw DeviceException(ErrorCode::invalid_work_group_size,
+					"radix sort needs work-groups of at least " + std::to_string(radix)
+					+ " work items but the device supports only " + std::to_string(local_size) + ".");
+			}
+			const auto groups = (count + local_size - 1) / local_size;
+			const auto flags = MemoryFlags{}.readWrite(true);
+			auto histograms = Buffer<cl_uint>{context, flags, radix * groups};
+			auto offsets = Buffer<cl_uint>{context, flags, radix * groups};
+			auto keys_temp = Buffer<KeyType>{context, flags, count};
+			auto values_temp = (values) ? Buffer<ValueType>{context, flags, count} : Buffer<ValueType>{context, flags, 1};
+			const Buffer<KeyType> * keys_in = &keys;
+			const Buffer<KeyType> * keys_out = &keys_temp;
+			const Buffer<ValueType> * values_in = values;
+			const Buffer<ValueType> * values_out = &values_temp;
+
+			auto wait = events_in_wait_list;
+			for (auto shift = cl_uint{0}; shift < 8 * sizeof(KeyType); shift += radix_bits) {
+				radix_count.setArgs(*keys_in, cl_ulong{count}, shift, histograms);
+				auto event = queue.enqueueNDRangeKernel(radix_count, 0, groups * local_size, local_size, wait);
+				event = scan(queue, histograms, offsets, radix * groups, ReduceOperator::sum(), false, {event});
+				radix_scatter.setArgs(
+					*keys_in, *keys_out, cl_ulong{count}, shift, offsets,
+					LocalMemory<BitsType>{local_size}, LocalMemory<cl_uint>{local_size}, LocalMemory<cl_uint>{local_size}
+				);
+				if (values) {
+					radix_scatter.setArg(8, *values_in);
+					radix_scatter.setArg(9, *values_out);
+				}
+				event = queue.enqueueNDRangeKernel(radix_scatter, 0, groups * local_size, local_size, {event});
+				wait = std::vector<Event>{event};
+				std::swap(keys_in, keys_out);
+				std::swap(values_in, values_out);
+			}
+			return wait.front();
+		}
+	}
+
+	template <typename KeyType>
+	Event sort(
+		CommandQueue & queue,
+		Buffer<KeyType> const& keys,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::sort<KeyType, KeyType>(queue, keys, nullptr, events_in_wait_list);
+	}
+
+	template <typename KeyType, typename ValueType>
+	Event sortByKey(
+		CommandQueue & queue,
+		Buffer<KeyType> const& keys,
+		Buffer<ValueType> const& values,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::sort(queue, keys, std::addressof(values), events_in_wait_list);
+	}
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef CPPCL_STENCIL_HEADER
+#define CPPCL_STENCIL_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "device.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+
+#include <array>
+#include <cassert>
+#include <string>
+#include <vector>
+
+/*
+ * Stencils and convolutions over dense 2D and 3D grids stored in buffers.
+ * Extents follow the rect commands: {width, height} or {width, height, depth}
+ * with width being the fastest-varying dimension.
+ *
+ * Every work-group loads its tile plus a halo of radius elements on each
+ * side into local memory once and evaluates all of its points from there.
+ * Reads outside of the grid are clamped to the nearest edge element.
+ *
+ * Radii, tile sizes and the coefficients are build defines, so every distinct
+ * stencil is its own program with fully unrolled constant coefficients.
+ * Coefficients are given row-major with width fastest, i.e. for a radius
+ * {rx, ry} there are (2 * rx + 1) * (2 * ry + 1) of them. They have to be
+ * finite; NaN or infinity throw a KernelException.
+ *
+ * convolve reads neighbours that other work-groups may already have written,
+ * so input and output must be distinct buffers.
+ *
+ * convolveSeparable applies the same 1D filter along every dimension, one pass
+ * per dimension, which reads far fewer elements for large radii. It may run
+ * in place.
+ */
+
+namespace cl {
+	namespace detail {
+		std::string stencilSource(ClTypeInfo const& type);
+		std::string stencilOptions(
+			ClTypeInfo const& type,
+			std::array<size_t, 3> const& radius,
+			std::array<size_t, 3> const& local_size,
+			std::vector<double> const& coefficients
+		);
+		std::array<size_t, 3> stencilLocalSize(
+			Device const& device,
+			size_t dimensions,
+			std::array<size_t, 3> const& radius,
+			size_t element_size,
+			size_t max_work_group_size
+		);
+
+		template <size_t N>
+		std::array<size_t, 3> extend(std::array<size_t, N> const& values, size_t fill) {
+			static_assert(N == 2 || N == 3, "stencils are only available for 2D and 3D grids.");
+			auto extended = std::array<size_t, 3>{{fill, fill, fill}};
+			for (auto i = size_t{0}; i < N; ++i) extended[i] = values[i];
+			return extended;
+		}
+
+		template <typename DataType>
+		Event stencil(
+			CommandQueue & queue,
+			Buffer<DataType> const& input,
+			Buffer<DataType> const& output,
+			size_t dimensions,
+			std::array<size_t, 3> const& extent,
+			std::array<size_t, 3> const& radius,
+			std::vector<double> const& coefficients,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			assert(coefficients.size() == (2 * radius[0] + 1) * (2 * radius[1] + 1) * (2 * radius[2] + 1));
+			assert(input.count_elements() >= extent[0] * extent[1] * extent[2]);
+			assert(output.count_elements() >= extent[0] * extent[1] * extent[2]);
+			const auto context = queue.context();
+			const auto device = queue.device();
+			const auto info = ClType<DataType>::info();
+			requireFloatingPoint(device, info.scalar);
+			auto max_work_group_size = device.maxWorkGroupSize();
+			while (true) {
+				const auto local_size = stencilLocalSize(device, dimensions, radius, sizeof(DataType), max_work_group_size);
+				const auto program = ProgramCache::get(
+					context, stencilSource(info), stencilOptions(info, radius, local_size, coefficients));
+				auto kernel = Kernel{program, "cppcl_stencil"};
+				const auto work_group_size = local_size[0] * local_size[1] * local_size[2];
+				const auto supported = kernel.workGroupSize(device);
+				if (work_group_size > supported && work_group_size > 1) {
+					max_work_group_size = supported;
+					continue;
+				}
+				kernel.setArgs(input, output, cl_uint(extent[0]), cl_uint(extent[1]), cl_uint(extent[2]));
+				auto global_size = std::array<size_t, 3>{};
+				for (auto i = size_t{0}; i < 3; ++i) {
+					global_size[i] = (extent[i] + local_size[i] - 1) / local_size[i] * local_size[i];
+				}
+				return queue.enqueueNDRangeKernel(kernel, global_size, local_size, events_in_wait_list);
+			}
+		}
+	}
+
+	template <typename DataType, size_t N>
+	Event convolve(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<DataType> const& output,
+		std::array<size_t, N> const& extent,
+		std::array<size_t, N> const& radius,
+		std::vector<double> const& coefficients,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		assert(input.id() != output.id());
+		return detail::stencil(
+			queue, input, output, N,
+			detail::extend(extent, 1), detail::extend(radius, 0),
+			coefficients, events_in_wait_list
+		);
+	}
+
+	template <typename DataType, size_t N>
+	Event convolveSeparable(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		Buffer<DataType> const& output,
+		std::array<size_t, N> const& extent,
+		std::vector<double> const& coefficients,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		assert(coefficients.size() % 2 == 1);
+		const auto full_extent = detail::extend(extent, 1);
+		auto temporary = Buffer<DataType>{
+			queue.context(), MemoryFlags{}.readWrite(true), full_extent[0] * full_extent[1] * full_extent[2]};
+		auto wait = events_in_wait_list;
+		const Buffer<DataType> * source = &input;
+		// For odd N the first pass writes output, so in-place calls read from a copy of the input.
+		auto staging = std::vector<Buffer<DataType>>{};
+		if (N % 2 == 1 && input.id() == output.id()) {
+			staging.push_back(Buffer<DataType>{
+				queue.context(), MemoryFlags{}.readWrite(true), temporary.count_elements()});
+			wait = std::vector<Event>{queue.enqueueCopyBuffer(input, staging.front(), temporary.count_elements(), wait)};
+			source = &staging.front();
+		}
+		for (auto dimension = size_t{0}; dimension < N; ++dimension) {
+			auto radius = std::array<size_t, 3>{{0, 0, 0}};
+			radius[dimension] = coefficients.size() / 2;
+			const auto * target = ((N - 1 - dimension) % 2 == 0) ? &output : &temporary;
+			const auto event = detail::stencil(
+				queue, *source, *target, N, full_extent, radius, coefficients, wait);
+			wait = std::vector<Event>{event};
+			source = target;
+		}
+		return wait.front();
+	}
+}
+
+#endif
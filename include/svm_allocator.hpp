@@ -0,0 +1,172 @@
+#ifndef CPPCL_SVM_ALLOCATOR_HEADER
+#define CPPCL_SVM_ALLOCATOR_HEADER
+
+#include "command_queue.hpp"
+#include "context.hpp"
+#include "map_buffer_flags.hpp"
+#include "event.hpp"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/*
+ * SvmAllocator<T> allocates shared virtual memory (OpenCL 2.0) and plugs into
+ * standard containers, so pointer-rich data structures can be handed to
+ * kernels without serialization:
+ *
+ *     auto allocator = SvmAllocator<Node>::fineGrainedIfAvailable(context);
+ *     auto nodes = SvmVector<Node>(allocator);
+ *     nodes.reserve(count);
+ *     {
+ *         SvmMapScope<Node> scope(queue, nodes, MapBufferFlags(CL_MAP_WRITE));
+ *         nodes.assign(count, Node{});
+ *     }
+ *     kernel.setArgs(nodes.data(), static_cast<cl_uint>(nodes.size()));
+ *     kernel.setIndirectSvmPointers({nodes.data()});
+ *
+ * Coarse-grained allocations are only coherent at map and unmap; host code
+ * touching them, including the construction of the elements, has to hold an
+ * SvmMapScope, which maps on construction and unmaps on destruction. The
+ * allocator does not map by itself, so a coarse-grained vector has to be
+ * reserved first and filled inside the scope; anything that reallocates it
+ * (growing beyond its capacity) must not happen outside of a scope either.
+ * The vector scope maps the whole capacity. For fine-grained allocations the
+ * scope does nothing.
+ */
+
+namespace cl {
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	namespace detail {
+		void * svmAlloc(Context const& context, cl_svm_mem_flags flags, size_t size, size_t alignment);
+		void svmFree(Context const& context, void * pointer);
+		cl_bool supportsFineGrainSvm(Context const& context);
+	}
+
+	// Not final: standard containers may derive from their allocator.
+	template <typename DataType>
+	class SvmAllocator {
+	private:
+		Context m_context;
+		cl_svm_mem_flags m_flags;
+
+		template <typename OtherType>
+		friend class SvmAllocator;
+
+	public:
+		using value_type = DataType;
+
+		template <typename OtherType>
+		struct rebind {
+			using other = SvmAllocator<OtherType>;
+		};
+
+		explicit SvmAllocator(Context const& context, cl_svm_mem_flags flags = CL_MEM_READ_WRITE) :
+			m_context{context},
+			m_flags{flags}
+		{}
+
+		template <typename OtherType>
+		SvmAllocator(SvmAllocator<OtherType> const& other) :
+			m_context{other.m_context},
+			m_flags{other.m_flags}
+		{}
+
+		static SvmAllocator fineGrainedIfAvailable(Context const& context, cl_svm_mem_flags flags = CL_MEM_READ_WRITE) {
+			return SvmAllocator{
+				context, (detail::supportsFineGrainSvm(context)) ? (flags | CL_MEM_SVM_FINE_GRAIN_BUFFER) : flags
+			};
+		}
+
+		DataType * allocate(size_t count_elements) {
+			return static_cast<DataType*>(detail::svmAlloc(
+				m_context, m_flags, count_elements * sizeof(DataType), alignof(DataType)
+			));
+		}
+
+		void deallocate(DataType * pointer, size_t) {
+			detail::svmFree(m_context, pointer);
+		}
+
+		Context const& context() const {
+			return m_context;
+		}
+
+		cl_svm_mem_flags flags() const {
+			return m_flags;
+		}
+
+		cl_bool isFineGrained() const {
+			return (m_flags & CL_MEM_SVM_FINE_GRAIN_BUFFER) != 0;
+		}
+
+		template <typename OtherType>
+		bool operator==(SvmAllocator<OtherType> const& other) const {
+			return m_context.id() == other.m_context.id() && m_flags == other.m_flags;
+		}
+
+		template <typename OtherType>
+		bool operator!=(SvmAllocator<OtherType> const& other) const {
+			return !(*this == other);
+		}
+	};
+
+	template <typename DataType>
+	using SvmVector = std::vector<DataType, SvmAllocator<DataType>>;
+
+	template <typename DataType>
+	class SvmMapScope final {
+	private:
+		CommandQueue m_queue;
+		DataType * m_pointer;
+		cl_bool m_mapped;
+
+	public:
+		SvmMapScope(
+			CommandQueue const& queue,
+			DataType * pointer,
+			size_t count_elements,
+			MapBufferFlags const& flags,
+			cl_bool fine_grained = false,
+			std::vector<Event> const& events_in_wait_list = {}
+		) :
+			m_queue{queue},
+			m_pointer{pointer},
+			m_mapped{!fine_grained && count_elements > 0}
+		{
+			if (m_mapped) {
+				m_queue.enqueueMapSvm(
+					m_pointer, count_elements * sizeof(DataType), flags, CommandSync::blocking, events_in_wait_list
+				);
+			}
+		}
+
+		SvmMapScope(
+			CommandQueue const& queue,
+			SvmVector<DataType> & data,
+			MapBufferFlags const& flags,
+			std::vector<Event> const& events_in_wait_list = {}
+		) :
+			SvmMapScope{
+				queue, data.data(), data.capacity(), flags, data.get_allocator().isFineGrained(), events_in_wait_list
+			}
+		{}
+
+		SvmMapScope(SvmMapScope const&) = delete;
+		SvmMapScope & operator=(SvmMapScope const&) = delete;
+
+		~SvmMapScope() {
+			if (m_mapped) {
+				m_queue.enqueueUnmapSvm(m_pointer);
+				m_queue.flush();
+			}
+		}
+
+		DataType * data() const {
+			return m_pointer;
+		}
+	};
+#endif
+}
+
+#endif
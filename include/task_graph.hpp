@@ -0,0 +1,76 @@
+#ifndef CPPCL_TASK_GRAPH_HEADER
+#define CPPCL_TASK_GRAPH_HEADER
+
+#include "command_queue.hpp"
+#include "context.hpp"
+#include "event.hpp"
+#include "thread_pool.hpp"
+
+#include <functional>
+#include <vector>
+
+/*
+ * TaskGraph executes a DAG of device commands and host tasks.
+ *
+ *     auto graph = TaskGraph{context};
+ *     auto upload = graph.addDevice(queue, [&](CommandQueue & q, std::vector<Event> const& wait) {
+ *         return q.enqueueWriteBufferAsync(buffer, data.begin(), data.end(), 0, wait);
+ *     });
+ *     auto prepare = graph.addHost([&] { fillTable(table); });
+ *     auto compute = graph.addDevice(queue, launchKernel, {upload, prepare});
+ *     auto events = graph.run();
+ *
+ * Nodes may only depend on nodes added before them, which keeps the graph
+ * acyclic by construction; run() enqueues in insertion order.
+ *
+ * Every host task gets a user event. Device commands are enqueued right
+ * away with the events of their dependencies (user events for host tasks)
+ * as wait list, so the OpenCL runtime holds them back until the host tasks
+ * have finished. Host tasks are started from event callbacks once all of
+ * their dependencies completed and run on a work-stealing ThreadPool; a
+ * failed dependency or an exception thrown by the task fails its user event.
+ * No thread ever blocks in Event::wait().
+ */
+
+namespace cl {
+	class TaskGraph final {
+	public:
+		using NodeId = size_t;
+		using DeviceCommand = std::function<Event(CommandQueue &, std::vector<Event> const&)>;
+		using HostTask = std::function<void()>;
+
+	private:
+		struct Node final {
+			std::vector<CommandQueue> queue;
+			DeviceCommand command;
+			HostTask task;
+			std::vector<NodeId> dependencies;
+		};
+
+		Context m_context;
+		ThreadPool & m_pool;
+		std::vector<Node> m_nodes;
+
+		NodeId addNode(Node node);
+
+	public:
+		TaskGraph(Context const& context, ThreadPool & pool = ThreadPool::shared());
+
+		NodeId addDevice(
+			CommandQueue const& queue,
+			DeviceCommand command,
+			std::vector<NodeId> const& dependencies = {});
+		NodeId addHost(
+			HostTask task,
+			std::vector<NodeId> const& dependencies = {});
+
+		void addDependency(NodeId node, NodeId dependency);
+
+		size_t size() const;
+
+		// Returns one event per node in insertion order; waiting on it is up to the caller.
+		std::vector<Event> run();
+	};
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef CPPCL_THREAD_POOL_HEADER
+#define CPPCL_THREAD_POOL_HEADER
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * ThreadPool runs host tasks on a fixed set of work-stealing worker threads.
+ *
+ * Every worker owns a task deque. Tasks submitted from a worker go to the
+ * back of its own deque and are taken from there again (newest first, warm
+ * caches for task chains); tasks submitted from other threads are spread
+ * round-robin. Idle workers steal the oldest task of another worker before
+ * they go to sleep.
+ *
+ * It backs host commands of command queues whose devices cannot execute
+ * native kernels and the host tasks of TaskGraph. ThreadPool::shared() is
+ * created on first use with one worker per hardware thread. Destroying a
+ * pool runs all tasks already submitted, then joins.
+ */
+
+namespace cl {
+	class ThreadPool final {
+	private:
+		struct WorkerQueue final {
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_wakeup;
+		size_t m_pending;
+		bool m_stopping;
+		std::atomic<size_t> m_next_queue;
+
+		bool take(size_t index, std::function<void()> & task);
+		void work(size_t index);
+
+	public:
+		explicit ThreadPool(size_t count_threads = std::thread::hardware_concurrency());
+		~ThreadPool();
+
+		ThreadPool(ThreadPool const&) = delete;
+		ThreadPool & operator=(ThreadPool const&) = delete;
+
+		void submit(std::function<void()> task);
+		size_t size() const;
+
+		static ThreadPool & shared();
+	};
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef CPPCL_TILED_EXECUTOR_HEADER
+#define CPPCL_TILED_EXECUTOR_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "event.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+/*
+ * TiledExecutor processes 2-dimensional host images of any size by splitting
+ * them into tiles that respect the image and allocation limits of all
+ * devices (CL_DEVICE_IMAGE2D_MAX_WIDTH/HEIGHT, CL_DEVICE_MAX_MEM_ALLOC_SIZE).
+ *
+ * Every tile covers a core region of the image plus a halo of the given
+ * width on each side (clamped at the image borders). The loaded region is
+ * uploaded with enqueueWriteBufferRect into a buffer with row pitch
+ * halo_extent[0], the user kernel computes the output into a buffer of the
+ * same layout, and only the core region is read back with
+ * enqueueReadBufferRect, so seams are never written twice.
+ *
+ * Tiles are distributed round-robin over the given queues; each queue owns
+ * one input and one output buffer and chains upload, kernel and readback of
+ * its tiles through events, so tiles of different queues overlap. Use
+ * several queues per device to overlap transfers with computation.
+ *
+ * The launch callback is invoked as
+ *     Event launch(CommandQueue & queue, Buffer<InType> const& input,
+ *                  Buffer<OutType> const& output, Tile const& tile,
+ *                  std::vector<Event> const& events_in_wait_list)
+ * Row pitches of host images are given in elements.
+ */
+
+namespace cl {
+	struct Tile final {
+		std::array<size_t, 2> origin;
+		std::array<size_t, 2> extent;
+		std::array<size_t, 2> halo_origin;
+		std::array<size_t, 2> halo_extent;
+		std::array<size_t, 2> core_offset;
+	};
+
+	namespace detail {
+		std::vector<Tile> tileGrid(
+			std::array<size_t, 2> const& image_extent,
+			std::array<size_t, 2> const& tile_extent,
+			size_t halo
+		);
+
+		std::array<size_t, 2> maxTileExtent(
+			std::vector<CommandQueue> const& queues,
+			size_t halo,
+			size_t bytes_per_pixel
+		);
+	}
+
+	template <typename InType, typename OutType = InType>
+	class TiledExecutor final {
+	private:
+		std::vector<CommandQueue> m_queues;
+		size_t m_halo;
+		std::array<size_t, 2> m_tile_extent;
+
+	public:
+		TiledExecutor(std::vector<CommandQueue> const& queues, size_t halo) :
+			TiledExecutor{queues, halo,
+				detail::maxTileExtent(queues, halo, std::max(sizeof(InType), sizeof(OutType)))}
+		{}
+
+		TiledExecutor(
+			std::vector<CommandQueue> const& queues,
+			size_t halo,
+			std::array<size_t, 2> const& tile_extent
+		) :
+			m_queues{queues},
+			m_halo{halo},
+			m_tile_extent{tile_extent}
+		{
+			assert(!queues.empty());
+			assert(tile_extent[0] > 0 && tile_extent[1] > 0);
+		}
+
+		size_t halo() const {
+			return m_halo;
+		}
+
+		std::array<size_t, 2> const& tileExtent() const {
+			return m_tile_extent;
+		}
+
+		std::vector<Tile> tiles(std::array<size_t, 2> const& image_extent) const {
+			return detail::tileGrid(image_extent, m_tile_extent, m_halo);
+		}
+
+		template <typename TileLauncher>
+		void run(
+			InType const* input,
+			size_t input_row_pitch,
+			OutType * output,
+			size_t output_row_pitch,
+			std::array<size_t, 2> const& image_extent,
+			TileLauncher launch
+		) {
+			assert(input_row_pitch >= image_extent[0] && output_row_pitch >= image_extent[0]);
+			const auto max_pixels = (m_tile_extent[0] + 2 * m_halo) * (m_tile_extent[1] + 2 * m_halo);
+			auto inputs = std::vector<Buffer<InType>>{};
+			auto outputs = std::vector<Buffer<OutType>>{};
+			auto pending = std::vector<std::vector<Event>>(m_queues.size());
+			for (auto&& queue : m_queues) {
+				const auto context = queue.context();
+				inputs.push_back(Buffer<InType>{context, MemoryFlags{CL_MEM_READ_ONLY}, max_pixels});
+				outputs.push_back(Buffer<OutType>{context, MemoryFlags{CL_MEM_READ_WRITE}, max_pixels});
+			}
+			const auto all_tiles = tiles(image_extent);
+			for (auto i = size_t{0}; i < all_tiles.size(); ++i) {
+				auto const& tile = all_tiles[i];
+				const auto q = i % m_queues.size();
+				auto & queue = m_queues[q];
+				const auto upload = queue.enqueueWriteBufferRectAsync<InType, InType const*, 2>(
+					inputs[q], input,
+					{{0, 0}}, tile.halo_origin, tile.halo_extent,
+					tile.halo_extent[0] * sizeof(InType), 0,
+					input_row_pitch * sizeof(InType), 0,
+					pending[q]
+				);
+				const auto computed = launch(
+					queue, inputs[q], outputs[q], tile, std::vector<Event>{upload});
+				const auto readback = queue.enqueueReadBufferRectAsync<OutType, OutType*, 2>(
+					outputs[q], output,
+					tile.core_offset, tile.origin, tile.extent,
+					tile.halo_extent[0] * sizeof(OutType), 0,
+					output_row_pitch * sizeof(OutType), 0,
+					std::vector<Event>{computed}
+				);
+				pending[q] = std::vector<Event>{readback};
+				queue.flush();
+			}
+			for (auto&& queue : m_queues) {
+				queue.finish();
+			}
+		}
+
+		template <typename TileLauncher>
+		void run(
+			InType const* input,
+			OutType * output,
+			std::array<size_t, 2> const& image_extent,
+			TileLauncher launch
+		) {
+			run(input, image_extent[0], output, image_extent[0], image_extent, launch);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef CPPCL_TOP_K_HEADER
+#define CPPCL_TOP_K_HEADER
+
+#include "command_queue.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "event.hpp"
+#include "cl_type.hpp"
+#include "program_cache.hpp"
+#include "reduce.hpp"
+#include "exception.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <vector>
+
+/*
+ * Selection of the k largest elements of a buffer in descending order
+ * without sorting it. Ties are ordered by ascending index.
+ *
+ * Every work item keeps a sorted candidate list of its grid-strided elements
+ * in private memory; each work-group merges the lists of its work items by a
+ * bitonic sort in local memory and emits its k best candidates. Passes repeat
+ * over the candidates of all work-groups while that shrinks them; otherwise
+ * a single work-group grid-strides over all remaining candidates.
+ *
+ * k is a build define and limited to small values (up to 256). If the input
+ * has fewer than k elements the remaining results are T_LOWEST with index
+ * ULONG_MAX. If the candidate list of a single work item exceeds the local
+ * memory of the device a DeviceException is thrown.
+ */
+
+namespace cl {
+	namespace detail {
+		std::string topKSource(ClTypeInfo const& type, size_t k);
+		size_t topKPadded(size_t k);
+
+		template <typename DataType>
+		ArgReduceResult<DataType> topK(
+			CommandQueue & queue,
+			Buffer<DataType> const& input,
+			size_t k,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			assert(k >= 1 && k <= 256);
+			const auto context = queue.context();
+			requireFloatingPoint(queue.device(), ClType<DataType>::info().scalar);
+			const auto program = ProgramCache::get(context, topKSource(ClType<DataType>::info(), k));
+			auto kernel = Kernel{program, "cppcl_top_k"};
+			const auto padded = topKPadded(k);
+			const auto local_size = fittingWorkGroupSize(
+				queue.device(), kernel, padded * (sizeof(DataType) + sizeof(cl_ulong)));
+			if (local_size == 0) {
+				throw DeviceException(ErrorCode::out_of_resources,
+					"the candidate lists for k = " + std::to_string(k)
+					+ " do not fit into the local memory of the device; sort the buffer instead.");
+			}
+			const auto flags = MemoryFlags{}.readWrite(true);
+			auto values = input;
+			auto indices = Buffer<cl_ulong>{context, flags, 1};
+			auto has_indices = cl_uint{0};
+			auto count = input.count_elements();
+			auto events = events_in_wait_list;
+			while (true) {
+				auto groups = std::max(std::min((count + local_size - 1) / local_size, local_size), size_t{1});
+				// Passes have to shrink the candidates; once they would not, one work-group finishes.
+				if (groups * k >= count) groups = 1;
+				auto out_values = Buffer<DataType>{context, flags, groups * k};
+				auto out_indices = Buffer<cl_ulong>{context, flags, groups * k};
+				kernel.setArgs(
+					values, indices, has_indices, cl_ulong{count}, out_values, out_indices,
+					LocalMemory<DataType>{local_size * padded}, LocalMemory<cl_ulong>{local_size * padded}
+				);
+				auto event = queue.enqueueNDRangeKernel(kernel, 0, groups * local_size, local_size, events);
+				if (groups == 1) return {out_values, out_indices, event};
+				values = out_values;
+				indices = out_indices;
+				has_indices = 1;
+				count = groups * k;
+				events = std::vector<Event>{event};
+			}
+		}
+	}
+
+	template <typename DataType>
+	ReduceResult<DataType> topK(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		size_t k,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		auto result = detail::topK(queue, input, k, events_in_wait_list);
+		return {result.value, result.event};
+	}
+
+	template <typename DataType>
+	ArgReduceResult<DataType> argTopK(
+		CommandQueue & queue,
+		Buffer<DataType> const& input,
+		size_t k,
+		std::vector<Event> const& events_in_wait_list = {}
+	) {
+		return detail::topK(queue, input, k, events_in_wait_list);
+	}
+}
+
+#endif
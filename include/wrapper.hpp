@@ -208,6 +208,15 @@ namespace cl {
 
 	enum class MemoryObjectType : cl_mem_object_type {
 		buffer = CL_MEM_OBJECT_BUFFER,
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		image1d        = CL_MEM_OBJECT_IMAGE1D,
+		image1d_buffer = CL_MEM_OBJECT_IMAGE1D_BUFFER,
+		image1d_array  = CL_MEM_OBJECT_IMAGE1D_ARRAY,
+		image2d_array  = CL_MEM_OBJECT_IMAGE2D_ARRAY,
+#endif
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+		pipe           = CL_MEM_OBJECT_PIPE,
+#endif
 		image2d = CL_MEM_OBJECT_IMAGE2D,
 		image3d = CL_MEM_OBJECT_IMAGE3D
 	};
@@ -289,7 +298,10 @@ namespace cl {
 		invalid_image_descriptor            = CL_INVALID_IMAGE_DESCRIPTOR,
 		invalid_compiler_options            = CL_INVALID_COMPILER_OPTIONS,
 		invalid_linker_options              = CL_INVALID_LINKER_OPTIONS,
-		invalid_device_partition_count      = CL_INVALID_DEVICE_PARTITION_COUNT
+		invalid_device_partition_count      = CL_INVALID_DEVICE_PARTITION_COUNT,
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+		invalid_pipe_size                   = CL_INVALID_PIPE_SIZE,
+#endif
 	};
 
 #if defined(CPPCL_CL_VERSION_1_2_ENABLED)
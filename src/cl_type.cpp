@@ -0,0 +1,24 @@
+#include "cl_type.hpp"
+#include "device.hpp"
+#include "fpconfig.hpp"
+#include "exception.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string typePreamble(ClTypeInfo const& type, std::string const& alias) {
+			return type.extensions
+				+ "typedef " + type.name + " " + alias + ";\n"
+				+ "#define " + alias + "_MAX " + type.max + "\n"
+				+ "#define " + alias + "_LOWEST " + type.lowest + "\n";
+		}
+
+		void requireFloatingPoint(Device const& device, ScalarType scalar) {
+			if (scalar == ScalarType::double_type && device.fpConfig(FloatingPointType::double_t).mask() == 0) {
+				throw DeviceException(
+					ErrorCode::invalid_device,
+					std::string{"the device does not support double precision floating point."}
+				);
+			}
+		}
+	}
+}
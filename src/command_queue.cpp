@@ -1,5 +1,7 @@
 #include "command_queue.hpp"
 #include "error_handler.hpp"
+#include "execution_capabilities.hpp"
+#include "thread_pool.hpp"
 
 namespace cl {
 	const error::ErrorMap CommandQueueInfo::error_map = {
@@ -25,8 +27,12 @@ namespace cl {
 		if (error::handle<CommandQueueException>(error, error_map)) m_id = new_id;
 	}
 
+	// Queried handles are not retained on our behalf while Context releases its handle
+	// on destruction, so the handle has to be retained before it is wrapped.
 	Context CommandQueue::context() const {
-		return {getInfo<cl_context>(CL_QUEUE_CONTEXT)};
+		const auto context_id = getInfo<cl_context>(CL_QUEUE_CONTEXT);
+		ContextInfo::func_retain(context_id);
+		return {context_id};
 	}
 
 	Device CommandQueue::device() const {
@@ -40,4 +46,257 @@ namespace cl {
 	CommandQueueProperties CommandQueue::properties() const {
 		return {getInfo<cl_command_queue_properties>(CL_QUEUE_PROPERTIES)};
 	}
+
+	void CommandQueue::flush() {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."}
+		};
+		error::handle<CommandQueueException>(clFlush(m_id), error_map);
+	}
+
+	void CommandQueue::finish() {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."}
+		};
+		error::handle<CommandQueueException>(clFinish(m_id), error_map);
+	}
+
+	cl_bool CommandQueue::nativeKernelSupport() const {
+		return (device().executionCapabilities().mask() & CL_EXEC_NATIVE_KERNEL) != 0;
+	}
+
+	Event CommandQueue::enqueueNativeKernel(
+		void (CL_CALLBACK * function)(void *),
+		void * args,
+		size_t args_size,
+		std::vector<cl_mem> const& memory_objects,
+		std::vector<const void*> const& memory_locations,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue and the context of the events in the wait list are not the same."},
+			{ErrorCode::invalid_value, "the given function or argument block is invalid."},
+			{ErrorCode::invalid_operation, "the device associated with this command queue cannot execute native kernels."},
+			{ErrorCode::invalid_memory_object, "one or more of the given memory objects are invalid."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+			{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given buffers."}
+		};
+		auto event_id = cl_event{0};
+		auto error = clEnqueueNativeKernel(
+			m_id,
+			function,
+			args,
+			args_size,
+			memory_objects.size(),
+			(memory_objects.empty()) ? nullptr : memory_objects.data(),
+			(memory_locations.empty()) ? nullptr : const_cast<const void**>(memory_locations.data()),
+			events_in_wait_list.size(),
+			(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+			std::addressof(event_id)
+		);
+		error::handle<CommandQueueException>(error, error_map);
+		return {event_id};
+	}
+
+	Event CommandQueue::enqueueHostTask(
+		std::function<void(std::vector<void*> const&)> task,
+		std::vector<cl_mem> const& memory_objects,
+		std::vector<size_t> const& sizes,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue, the given buffers and the events in the wait list are not the same."},
+			{ErrorCode::invalid_memory_object, "one or more of the given buffers are invalid."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+			{ErrorCode::map_failure, "failed to map a buffer into the host address space."},
+			{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for data store associated with the given buffers."},
+			{ErrorCode::invalid_operation, "a buffer has been created with host access flags prohibiting read and write mappings."}
+		};
+		auto pointers = std::vector<void*>{};
+		auto gate = std::vector<Event>{};
+		for (auto i = size_t{0}; i < memory_objects.size(); ++i) {
+			auto event_id = cl_event{0};
+			auto error = cl_int{CL_INVALID_VALUE};
+			pointers.push_back(clEnqueueMapBuffer(
+				m_id,
+				memory_objects[i],
+				CL_FALSE,
+				CL_MAP_READ | CL_MAP_WRITE,
+				0,
+				sizes[i],
+				events_in_wait_list.size(),
+				(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+				std::addressof(event_id),
+				std::addressof(error)
+			));
+			error::handle<CommandQueueException>(error, error_map);
+			gate.push_back(Event{event_id});
+		}
+		if (memory_objects.empty()) {
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+			gate.push_back(enqueueMarker(events_in_wait_list));
+#else
+			gate = events_in_wait_list;
+#endif
+		}
+		auto done = Event{context()};
+		// The gate is observed through completion callbacks so no pool worker waits on it.
+		detail::whenComplete(gate, [task, pointers, done](cl_bool failed) {
+			ThreadPool::shared().submit([task, pointers, done, failed]() mutable {
+				if (failed) {
+					done.fail();
+					return;
+				}
+				try {
+					task(pointers);
+				} catch (...) {
+					done.fail();
+					return;
+				}
+				done.finish();
+			});
+		});
+		flush();
+		auto done_list = std::vector<Event>{done};
+		for (auto i = size_t{0}; i < memory_objects.size(); ++i) {
+			auto event_id = cl_event{0};
+			auto error = clEnqueueUnmapMemObject(
+				m_id,
+				memory_objects[i],
+				pointers[i],
+				1,
+				reinterpret_cast<const cl_event*>(done_list.data()),
+				std::addressof(event_id)
+			);
+			error::handle<CommandQueueException>(error, error_map);
+			done_list.push_back(Event{event_id});
+		}
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+		// The barrier keeps later commands of this queue behind the host task, also without buffers.
+		return enqueueBarrier(done_list);
+#else
+		return done_list.back();
+#endif
+	}
+
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+	Event CommandQueue::enqueueMarker(std::vector<Event> const& events_in_wait_list) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue and the context of the events in the wait list are not the same."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."}
+		};
+		auto event_id = cl_event{0};
+		auto error = clEnqueueMarkerWithWaitList(
+			m_id,
+			events_in_wait_list.size(),
+			(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+			std::addressof(event_id)
+		);
+		error::handle<CommandQueueException>(error, error_map);
+		return {event_id};
+	}
+
+	Event CommandQueue::enqueueBarrier(std::vector<Event> const& events_in_wait_list) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue and the context of the events in the wait list are not the same."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."}
+		};
+		auto event_id = cl_event{0};
+		auto error = clEnqueueBarrierWithWaitList(
+			m_id,
+			events_in_wait_list.size(),
+			(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+			std::addressof(event_id)
+		);
+		error::handle<CommandQueueException>(error, error_map);
+		return {event_id};
+	}
+
+	Event CommandQueue::enqueueMigrateMemoryObjects(
+		std::vector<MemoryObject> const& memory_objects,
+		cl_mem_migration_flags flags,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue and the context of the memory objects or events in the wait list are not the same."},
+			{ErrorCode::invalid_memory_object, "one or more of the given memory objects are invalid."},
+			{ErrorCode::invalid_value, "no memory objects were given; OR the given migration flags are invalid."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."},
+			{ErrorCode::memory_object_allocation_failure, "failed to allocate memory for the data store of one or more of the given memory objects."}
+		};
+		auto ids = std::vector<cl_mem>{};
+		for (auto&& memory_object : memory_objects) {
+			ids.push_back(memory_object.id());
+		}
+		auto event_id = cl_event{0};
+		auto error = clEnqueueMigrateMemObjects(
+			m_id,
+			ids.size(),
+			ids.data(),
+			flags,
+			events_in_wait_list.size(),
+			(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+			std::addressof(event_id)
+		);
+		error::handle<CommandQueueException>(error, error_map);
+		return {event_id};
+	}
+#endif
+
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	Event CommandQueue::enqueueMapSvm(
+		void * svm_pointer,
+		size_t size,
+		MapBufferFlags const& flags,
+		CommandSync sync,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue and the context of the events in the wait list are not the same."},
+			{ErrorCode::invalid_value, "the given pointer is null; OR the given size is zero; OR the given flags are invalid."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."}
+		};
+		auto event_id = cl_event{0};
+		auto error = clEnqueueSVMMap(
+			m_id,
+			static_cast<cl_bool>(sync),
+			flags.mask(),
+			svm_pointer,
+			size,
+			events_in_wait_list.size(),
+			(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+			std::addressof(event_id)
+		);
+		error::handle<CommandQueueException>(error, error_map);
+		return {event_id};
+	}
+
+	Event CommandQueue::enqueueUnmapSvm(
+		void * svm_pointer,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_command_queue, "this command queue is invalid."},
+			{ErrorCode::invalid_context, "the context of this command queue and the context of the events in the wait list are not the same."},
+			{ErrorCode::invalid_value, "the given pointer is null."},
+			{ErrorCode::invalid_event_wait_list, "one or more event objects in the given event list are invalid."}
+		};
+		auto event_id = cl_event{0};
+		auto error = clEnqueueSVMUnmap(
+			m_id,
+			svm_pointer,
+			events_in_wait_list.size(),
+			(events_in_wait_list.empty()) ? nullptr : reinterpret_cast<const cl_event*>(events_in_wait_list.data()),
+			std::addressof(event_id)
+		);
+		error::handle<CommandQueueException>(error, error_map);
+		return {event_id};
+	}
+#endif
 }
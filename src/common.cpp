@@ -26,5 +26,18 @@ namespace cl {
 			}
 			return result;
 		}
+
+		size_t gcd(size_t a, size_t b) {
+			while (b != 0) {
+				const auto t = a % b;
+				a = b;
+				b = t;
+			}
+			return a;
+		}
+
+		size_t lcm(size_t a, size_t b) {
+			return (a == 0 || b == 0) ? 0 : (a / gcd(a, b)) * b;
+		}
 	}
 }
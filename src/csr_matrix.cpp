@@ -0,0 +1,85 @@
+#include "csr_matrix.hpp"
+#include "device.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+
+#if defined(CPPCL_CL_VERSION_1_1_ENABLED)
+namespace cl {
+	namespace detail {
+		CsrLayout csrLayout(Context const& context, size_t rows, size_t non_zeros, size_t value_size) {
+			auto alignment = size_t{1};
+			for (auto&& device : context.devices()) {
+				alignment = common::lcm(alignment, device.memoryBaseAddressAlign() / 8);
+			}
+			const auto align = [alignment](size_t offset) {
+				return (offset + alignment - 1) / alignment * alignment;
+			};
+			const auto count = std::max(non_zeros, size_t{1});
+			auto layout = CsrLayout{};
+			layout.column_indices_offset = align((rows + 1) * sizeof(cl_uint));
+			layout.values_offset = align(layout.column_indices_offset + count * sizeof(cl_uint));
+			layout.size = layout.values_offset + count * value_size;
+			return layout;
+		}
+
+		std::string spmvSource(ClTypeInfo const& type) {
+			return typePreamble(type) + R"(
+__kernel void cppcl_spmv_scalar(
+	uint rows,
+	__global const uint * row_offsets,
+	__global const uint * column_indices,
+	__global const T * values,
+	__global const T * x,
+	__global T * y
+) {
+	const size_t row = get_global_id(0);
+	if (row >= rows) return;
+	T sum = (T)0;
+	for (uint j = row_offsets[row]; j < row_offsets[row + 1]; ++j) {
+		sum += values[j] * x[column_indices[j]];
+	}
+	y[row] = sum;
+}
+
+__kernel void cppcl_spmv_vector(
+	uint rows,
+	__global const uint * row_offsets,
+	__global const uint * column_indices,
+	__global const T * values,
+	__global const T * x,
+	__global T * y,
+	uint lanes,
+	__local T * partial
+) {
+	const uint lid = get_local_id(0);
+	const uint lane = lid & (lanes - 1);
+	const size_t row = get_global_id(0) / lanes;
+	T sum = (T)0;
+	if (row < rows) {
+		for (uint j = row_offsets[row] + lane; j < row_offsets[row + 1]; j += lanes) {
+			sum += values[j] * x[column_indices[j]];
+		}
+	}
+	partial[lid] = sum;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (uint offset = lanes >> 1; offset > 0; offset >>= 1) {
+		if (lane < offset) partial[lid] += partial[lid + offset];
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (lane == 0 && row < rows) y[row] = partial[lid];
+}
+)";
+		}
+
+		size_t spmvLanes(double average_row_length, size_t work_group_size) {
+			const auto min_vector_row_length = 8.0;
+			const auto max_lanes = std::min(size_t{32}, work_group_size);
+			if (average_row_length < min_vector_row_length || max_lanes < 2) return 1;
+			auto lanes = size_t{2};
+			while (lanes * 2 <= max_lanes && static_cast<double>(lanes * 2) <= average_row_length) lanes *= 2;
+			return lanes;
+		}
+	}
+}
+#endif
@@ -153,6 +153,30 @@ namespace cl {
 		return getInfo<size_t>(CL_DEVICE_IMAGE3D_MAX_DEPTH);
 	}
 
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+	size_t Device::maxBufferSizeImage1D() const {
+		return getInfo<size_t>(CL_DEVICE_IMAGE_MAX_BUFFER_SIZE);
+	}
+#endif
+
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	cl_device_svm_capabilities Device::svmCapabilities() const {
+		return getInfo<cl_device_svm_capabilities>(CL_DEVICE_SVM_CAPABILITIES);
+	}
+
+	cl_uint Device::maxPipeArguments() const {
+		return getInfo<cl_uint>(CL_DEVICE_MAX_PIPE_ARGS);
+	}
+
+	cl_uint Device::pipeMaxActiveReservations() const {
+		return getInfo<cl_uint>(CL_DEVICE_PIPE_MAX_ACTIVE_RESERVATIONS);
+	}
+
+	cl_uint Device::pipeMaxPacketSize() const {
+		return getInfo<cl_uint>(CL_DEVICE_PIPE_MAX_PACKET_SIZE);
+	}
+#endif
+
 	cl_ulong Device::localMemorySize() const {
 		return getInfo<cl_ulong>(CL_DEVICE_LOCAL_MEM_SIZE);
 	}
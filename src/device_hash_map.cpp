@@ -0,0 +1,149 @@
+#include "device_hash_map.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string hashMapSource(ClTypeInfo const& key, size_t key_size, ClTypeInfo const& value) {
+			auto source = typePreamble(key) + typePreamble(value, "V");
+			if (key_size == 8) {
+				source += R"(
+#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable
+typedef ulong K;
+#define CPPCL_CAS(p, compare, value) atom_cmpxchg((p), (compare), (value))
+inline ulong cppcl_hash(K k) {
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdUL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53UL;
+	k ^= k >> 33;
+	return k;
+}
+)";
+			} else {
+				source += R"(
+typedef uint K;
+#define CPPCL_CAS(p, compare, value) atomic_cmpxchg((p), (compare), (value))
+inline ulong cppcl_hash(K k) {
+	k ^= k >> 16;
+	k *= 0x85ebca6bU;
+	k ^= k >> 13;
+	k *= 0xc2b2ae35U;
+	k ^= k >> 16;
+	return k;
+}
+)";
+			}
+			return source + R"(
+#define EMPTY ((K)(~(K)0))
+#define KEYS(table) ((__global K *)(table))
+#define VALUES(table) ((__global V *)((table) + values_offset))
+
+__kernel void cppcl_hash_map_clear(
+	__global uchar * table,
+	ulong capacity,
+	__global uint * failed
+) {
+	const size_t i = get_global_id(0);
+	if (i < capacity) KEYS(table)[i] = EMPTY;
+	if (i == 0) *failed = 0;
+}
+
+__kernel void cppcl_hash_map_reset_counter(__global uint * counter) {
+	*counter = 0;
+}
+
+__kernel void cppcl_hash_map_insert(
+	__global uchar * table,
+	ulong capacity,
+	ulong values_offset,
+	__global uint * failed,
+	__global const T * keys,
+	__global const V * values,
+	uint use_values,
+	ulong count
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	const K key = (K)keys[i];
+	const V value = (use_values) ? values[i] : (V)i;
+	size_t slot = cppcl_hash(key) & (capacity - 1);
+	for (size_t probe = 0; probe < capacity; ++probe) {
+		const K previous = CPPCL_CAS(&KEYS(table)[slot], EMPTY, key);
+		if (previous == EMPTY || previous == key) {
+			VALUES(table)[slot] = value;
+			return;
+		}
+		slot = (slot + 1) & (capacity - 1);
+	}
+	atomic_inc(failed);
+}
+
+inline long cppcl_hash_map_lookup(__global const uchar * table, ulong capacity, K key) {
+	size_t slot = cppcl_hash(key) & (capacity - 1);
+	for (size_t probe = 0; probe < capacity; ++probe) {
+		const K current = ((__global const K *)table)[slot];
+		if (current == key) return (long)slot;
+		if (current == EMPTY) return -1;
+		slot = (slot + 1) & (capacity - 1);
+	}
+	return -1;
+}
+
+__kernel void cppcl_hash_map_find(
+	__global const uchar * table,
+	ulong capacity,
+	ulong values_offset,
+	__global const T * keys,
+	__global V * values,
+	V missing,
+	ulong count
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	const long slot = cppcl_hash_map_lookup(table, capacity, (K)keys[i]);
+	values[i] = (slot < 0) ? missing : ((__global const V *)(table + values_offset))[slot];
+}
+
+__kernel void cppcl_hash_map_contains(
+	__global const uchar * table,
+	ulong capacity,
+	__global const T * keys,
+	__global uint * found,
+	ulong count
+) {
+	const size_t i = get_global_id(0);
+	if (i < count) found[i] = (cppcl_hash_map_lookup(table, capacity, (K)keys[i]) >= 0) ? 1 : 0;
+}
+
+__kernel void cppcl_hash_map_join(
+	__global const uchar * table,
+	ulong capacity,
+	ulong values_offset,
+	__global const T * probe_keys,
+	ulong count,
+	__global V * matched_values,
+	__global uint * matched_indices,
+	__global uint * matched_count
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	const long slot = cppcl_hash_map_lookup(table, capacity, (K)probe_keys[i]);
+	if (slot < 0) return;
+	const uint position = atomic_inc(matched_count);
+	matched_values[position] = ((__global const V *)(table + values_offset))[slot];
+	matched_indices[position] = (uint)i;
+}
+)";
+		}
+
+		size_t hashMapCapacity(size_t count_elements) {
+			auto capacity = size_t{16};
+			while (capacity < 2 * count_elements) capacity *= 2;
+			return capacity;
+		}
+
+		size_t hashMapValuesOffset(size_t capacity, size_t key_size) {
+			const auto alignment = size_t{128};
+			return (capacity * key_size + alignment - 1) / alignment * alignment;
+		}
+	}
+}
@@ -0,0 +1,315 @@
+#include "device_selector.hpp"
+#include "platform.hpp"
+#include "context.hpp"
+#include "context_properties.hpp"
+#include "command_queue.hpp"
+#include "command_queue_properties.hpp"
+#include "buffer.hpp"
+#include "kernel.hpp"
+#include "program.hpp"
+#include "exception.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+
+namespace cl {
+	namespace {
+		using CacheKey = std::tuple<std::string, std::string, std::string>;
+
+		std::mutex cache_mutex;
+		std::map<CacheKey, DeviceProfile> cache;
+
+		const auto selector_source = std::string{R"(
+			__kernel void cppcl_select_fma(__global float * out, uint iterations) {
+				const float seed = (float)get_global_id(0) * 1.0e-6f;
+				float x = seed;
+				float y = seed + 1.0f;
+				float z = seed + 2.0f;
+				float w = seed + 3.0f;
+				for (uint i = 0; i < iterations; ++i) {
+					x = fma(x, 0.999f, 0.001f);
+					y = fma(y, 0.999f, 0.001f);
+					z = fma(z, 0.999f, 0.001f);
+					w = fma(w, 0.999f, 0.001f);
+				}
+				out[get_global_id(0)] = x + y + z + w;
+			}
+
+			__kernel void cppcl_select_empty(__global float * out) {
+				if (get_global_id(0) == (size_t)(-1)) out[0] = 0.0f;
+			}
+		)"};
+
+		constexpr auto count_runs = 3;
+		constexpr auto min_kernel_seconds = 2.0e-3;
+		constexpr auto max_fma_iterations = cl_uint{1} << 20;
+		constexpr auto max_transfer_bytes = cl_ulong{32} << 20;
+
+		CacheKey cacheKey(Device const& device) {
+			return CacheKey{device.platform().name(), device.name(), device.driverVersion()};
+		}
+
+		template <typename Function>
+		double bestSeconds(Function function) {
+			auto best = std::numeric_limits<double>::max();
+			for (auto i = 0; i < count_runs; ++i) {
+				const auto start = std::chrono::steady_clock::now();
+				function();
+				const auto end = std::chrono::steady_clock::now();
+				best = std::min(best, std::chrono::duration<double>(end - start).count());
+			}
+			return std::max(best, 1.0e-9);
+		}
+
+		DeviceProfile measure(Device const& device) {
+			auto user_data = int{0};
+			auto context = Context(
+				ContextProperties().setPlatform(device.platform()),
+				std::vector<Device>{device},
+				[](std::string const&, std::vector<uint8_t> const&, int) {},
+				user_data
+			);
+			auto queue = CommandQueue(context, device, CommandQueueProperties{});
+			auto profile = DeviceProfile{};
+
+			const auto count = static_cast<size_t>(
+				std::min(max_transfer_bytes, device.maxMemoryAllocationSize() / 4) / sizeof(cl_uint));
+			const auto bytes = static_cast<double>(count * sizeof(cl_uint));
+			auto host = std::vector<cl_uint>(count, 1);
+			auto src = Buffer<cl_uint>{context, MemoryFlags{}.readWrite(true), count};
+			auto dst = Buffer<cl_uint>{context, MemoryFlags{}.readWrite(true), count};
+			queue.enqueueWrite(src, host.begin(), host.end());
+			profile.host_to_device_bandwidth = bytes / bestSeconds([&] {
+				queue.enqueueWrite(src, host.begin(), host.end());
+			});
+			profile.device_to_host_bandwidth = bytes / bestSeconds([&] {
+				queue.enqueueRead(src, host.begin(), host.end());
+			});
+			queue.enqueueCopyBuffer(src, dst, count);
+			queue.finish();
+			// A copy reads and writes every byte.
+			profile.device_copy_bandwidth = 2.0 * bytes / bestSeconds([&] {
+				queue.enqueueCopyBuffer(src, dst, count);
+				queue.finish();
+			});
+
+			// Built locally: a cached program would keep this throwaway context alive.
+			auto program = Program{context, selector_source};
+			program.build();
+			auto fma = Kernel{program, "cppcl_select_fma"};
+			const auto global_size =
+				static_cast<size_t>(device.maxComputeUnits()) * std::min(device.maxWorkGroupSize(), size_t{256}) * 4;
+			auto out = Buffer<cl_float>{context, MemoryFlags{}.readWrite(true), global_size};
+			auto iterations = cl_uint{64};
+			auto seconds = 0.0;
+			for (;;) {
+				fma.setArgs(out, iterations);
+				seconds = bestSeconds([&] {
+					queue.enqueueNDRangeKernel(fma, global_size);
+					queue.finish();
+				});
+				if (seconds >= min_kernel_seconds || iterations >= max_fma_iterations) break;
+				iterations *= 2;
+			}
+			// Four independent chains of one fma (two operations) per iteration.
+			profile.fma_throughput = 8.0 * static_cast<double>(global_size) * iterations / seconds;
+
+			auto empty = Kernel{program, "cppcl_select_empty"};
+			empty.setArgs(out);
+			queue.enqueueNDRangeKernel(empty, 1);
+			queue.finish();
+			profile.launch_latency = bestSeconds([&] {
+				queue.enqueueNDRangeKernel(empty, 1);
+				queue.finish();
+			});
+			return profile;
+		}
+	}
+
+	DeviceScoreWeights::DeviceScoreWeights() :
+		m_host_to_device{1.0},
+		m_device_to_host{1.0},
+		m_device_copy{1.0},
+		m_fma{1.0},
+		m_launch_latency{1.0}
+	{}
+
+	DeviceScoreWeights & DeviceScoreWeights::hostToDevice(double weight) {
+		m_host_to_device = weight;
+		return * this;
+	}
+
+	DeviceScoreWeights & DeviceScoreWeights::deviceToHost(double weight) {
+		m_device_to_host = weight;
+		return * this;
+	}
+
+	DeviceScoreWeights & DeviceScoreWeights::deviceCopy(double weight) {
+		m_device_copy = weight;
+		return * this;
+	}
+
+	DeviceScoreWeights & DeviceScoreWeights::fma(double weight) {
+		m_fma = weight;
+		return * this;
+	}
+
+	DeviceScoreWeights & DeviceScoreWeights::launchLatency(double weight) {
+		m_launch_latency = weight;
+		return * this;
+	}
+
+	double DeviceScoreWeights::hostToDevice() const {
+		return m_host_to_device;
+	}
+
+	double DeviceScoreWeights::deviceToHost() const {
+		return m_device_to_host;
+	}
+
+	double DeviceScoreWeights::deviceCopy() const {
+		return m_device_copy;
+	}
+
+	double DeviceScoreWeights::fma() const {
+		return m_fma;
+	}
+
+	double DeviceScoreWeights::launchLatency() const {
+		return m_launch_latency;
+	}
+
+	DeviceProfile DeviceSelector::profile(Device const& device) {
+		auto key = cacheKey(device);
+		{
+			std::lock_guard<std::mutex> lock{cache_mutex};
+			const auto found = cache.find(key);
+			if (found != cache.end()) return found->second;
+		}
+		// Measured without holding the lock; concurrent first calls may measure twice and the first result wins.
+		const auto profile = measure(device);
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		return cache.emplace(std::move(key), profile).first->second;
+	}
+
+	std::vector<double> DeviceSelector::scores(
+		std::vector<Device> const& devices, DeviceScoreWeights const& weights
+	) {
+		// Devices failing to run the benchmarks stay unmeasured and are ranked last.
+		auto profiles = std::vector<DeviceProfile>{};
+		auto measured = std::vector<bool>{};
+		for (auto&& device : devices) {
+			try {
+				profiles.push_back(profile(device));
+				measured.push_back(true);
+			} catch (Exception const&) {
+				profiles.push_back(DeviceProfile{});
+				measured.push_back(false);
+			}
+		}
+		if (!devices.empty() && std::none_of(measured.begin(), measured.end(), [](bool m) { return m; })) {
+			throw DeviceException(ErrorCode::device_not_found,
+				std::string{"none of the devices could be measured."});
+		}
+		auto best = DeviceProfile{0.0, 0.0, 0.0, 0.0, std::numeric_limits<double>::max()};
+		for (auto i = size_t{0}; i < profiles.size(); ++i) {
+			if (!measured[i]) continue;
+			const auto& p = profiles[i];
+			best.host_to_device_bandwidth = std::max(best.host_to_device_bandwidth, p.host_to_device_bandwidth);
+			best.device_to_host_bandwidth = std::max(best.device_to_host_bandwidth, p.device_to_host_bandwidth);
+			best.device_copy_bandwidth = std::max(best.device_copy_bandwidth, p.device_copy_bandwidth);
+			best.fma_throughput = std::max(best.fma_throughput, p.fma_throughput);
+			best.launch_latency = std::min(best.launch_latency, p.launch_latency);
+		}
+		auto scores = std::vector<double>{};
+		for (auto i = size_t{0}; i < profiles.size(); ++i) {
+			if (!measured[i]) {
+				scores.push_back(-std::numeric_limits<double>::infinity());
+				continue;
+			}
+			const auto& p = profiles[i];
+			scores.push_back(
+				weights.hostToDevice() * std::log(p.host_to_device_bandwidth / best.host_to_device_bandwidth) +
+				weights.deviceToHost() * std::log(p.device_to_host_bandwidth / best.device_to_host_bandwidth) +
+				weights.deviceCopy() * std::log(p.device_copy_bandwidth / best.device_copy_bandwidth) +
+				weights.fma() * std::log(p.fma_throughput / best.fma_throughput) +
+				weights.launchLatency() * std::log(best.launch_latency / p.launch_latency)
+			);
+		}
+		return scores;
+	}
+
+	std::vector<Device> DeviceSelector::rank(
+		std::vector<Device> const& devices, DeviceScoreWeights const& weights
+	) {
+		const auto device_scores = scores(devices, weights);
+		auto order = std::vector<size_t>(devices.size());
+		std::iota(order.begin(), order.end(), size_t{0});
+		std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+			return device_scores[lhs] > device_scores[rhs];
+		});
+		auto ranked = std::vector<Device>{};
+		for (auto&& index : order) {
+			ranked.push_back(devices[index]);
+		}
+		return ranked;
+	}
+
+	Device DeviceSelector::best(
+		std::vector<Device> const& devices, DeviceScoreWeights const& weights
+	) {
+		if (devices.empty()) {
+			throw DeviceException(ErrorCode::device_not_found,
+				std::string{"there are no devices to select from."});
+		}
+		return rank(devices, weights).front();
+	}
+
+	// One line per profile: platform, device and driver version separated by tabs, then the figures.
+	void DeviceSelector::save(std::string const& path) {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		auto file = std::ofstream{path};
+		file.precision(std::numeric_limits<double>::max_digits10);
+		for (auto&& entry : cache) {
+			const auto& p = entry.second;
+			file << std::get<0>(entry.first) << '\t' << std::get<1>(entry.first) << '\t' << std::get<2>(entry.first) << '\t'
+				 << p.host_to_device_bandwidth << ' ' << p.device_to_host_bandwidth << ' '
+				 << p.device_copy_bandwidth << ' ' << p.fma_throughput << ' ' << p.launch_latency << '\n';
+		}
+	}
+
+	// A missing or partly malformed file only means that devices get measured again.
+	void DeviceSelector::load(std::string const& path) {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		auto file = std::ifstream{path};
+		auto line = std::string{};
+		while (std::getline(file, line)) {
+			auto stream = std::istringstream{line};
+			auto platform = std::string{};
+			auto device = std::string{};
+			auto driver = std::string{};
+			auto p = DeviceProfile{};
+			if (std::getline(stream, platform, '\t')
+				&& std::getline(stream, device, '\t')
+				&& std::getline(stream, driver, '\t')
+				&& (stream >> p.host_to_device_bandwidth >> p.device_to_host_bandwidth
+					>> p.device_copy_bandwidth >> p.fma_throughput >> p.launch_latency)
+			) {
+				cache[CacheKey{platform, device, driver}] = p;
+			}
+		}
+	}
+
+	void DeviceSelector::clear() {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		cache.clear();
+	}
+}
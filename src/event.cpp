@@ -1,6 +1,7 @@
 #include "event.hpp"
 #include "command_queue.hpp"
 
+#include <atomic>
 #include <type_traits>
 
 namespace cl {
@@ -81,11 +82,14 @@ namespace cl {
 		auto error = (queue == NULL) ? ErrorCode::invalid_event : ErrorCode::success;
 		error::handle<EventException>(error, error_map);
 		//return {queue}; //invalid due to cyclic dependency with command_queue.hpp
+		CommandQueueInfo::func_retain(queue);
 		return std::make_unique<CommandQueue>(queue);
 	}
 
 	Context Event::context() const {
-		return {getInfo<cl_context>(CL_EVENT_CONTEXT)};
+		const auto context_id = getInfo<cl_context>(CL_EVENT_CONTEXT);
+		ContextInfo::func_retain(context_id);
+		return {context_id};
 	}
 
 	CommandType Event::commandType() const {
@@ -104,6 +108,35 @@ namespace cl {
 		return getInfo<cl_uint>(CL_EVENT_REFERENCE_COUNT);
 	}
 
+	cl_ulong Event::getProfilingInfo(cl_profiling_info info_id) const {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::profiling_info_not_available, "the command queue of this event has no profiling enabled; OR the command has not yet completed; OR this is a user event."},
+			{ErrorCode::invalid_value, "invalid profiling information queried."},
+			{ErrorCode::invalid_event, "the given event is invalid."}
+		};
+		auto info = cl_ulong{0};
+		auto error = clGetEventProfilingInfo(
+			m_id, info_id, sizeof(cl_ulong), std::addressof(info), nullptr);
+		error::handle<EventException>(error, error_map);
+		return info;
+	}
+
+	cl_ulong Event::profilingCommandQueued() const {
+		return getProfilingInfo(CL_PROFILING_COMMAND_QUEUED);
+	}
+
+	cl_ulong Event::profilingCommandSubmit() const {
+		return getProfilingInfo(CL_PROFILING_COMMAND_SUBMIT);
+	}
+
+	cl_ulong Event::profilingCommandStart() const {
+		return getProfilingInfo(CL_PROFILING_COMMAND_START);
+	}
+
+	cl_ulong Event::profilingCommandEnd() const {
+		return getProfilingInfo(CL_PROFILING_COMMAND_END);
+	}
+
 	void Event::waitForEvents(std::vector<Event> const& events) {
 		static const auto error_map = error::ErrorMap{
 			{ErrorCode::invalid_context, "not all given events do belong to the same context."},
@@ -115,4 +148,43 @@ namespace cl {
 			reinterpret_cast<const cl_event*>(events.data()));
 		error::handle<EventException>(error, error_map);
 	}
+
+	namespace {
+		struct Continuation final {
+			std::function<void(cl_bool)> function;
+			std::atomic<size_t> remaining;
+			std::atomic<bool> failed;
+
+			Continuation(std::function<void(cl_bool)> function, size_t count_events) :
+				function{std::move(function)},
+				remaining{count_events},
+				failed{false}
+			{}
+		};
+
+		void onEventComplete(cl_event, cl_int status, void * user_data) {
+			auto state = std::unique_ptr<std::shared_ptr<Continuation>>{
+				static_cast<std::shared_ptr<Continuation>*>(user_data)};
+			if (status < 0) (*state)->failed = true;
+			if ((*state)->remaining.fetch_sub(1) == 1) {
+				(*state)->function((*state)->failed);
+			}
+		}
+	}
+
+	namespace detail {
+		void whenComplete(std::vector<Event> events, std::function<void(cl_bool)> continuation) {
+			if (events.empty()) {
+				continuation(false);
+				return;
+			}
+			auto state = std::make_shared<Continuation>(std::move(continuation), events.size());
+			for (auto&& event : events) {
+				event.callback(
+					CommandExecutionCallbackType::complete,
+					onEventComplete,
+					new std::shared_ptr<Continuation>{state});
+			}
+		}
+	}
 }
@@ -0,0 +1,19 @@
+#include "expression.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string fusedSource(
+			ClTypeInfo const& output,
+			std::string const& extensions,
+			std::string const& parameters,
+			std::string const& expression
+		) {
+			return extensions + output.extensions
+				+ "__kernel void cppcl_fused(\n\t__global " + output.name + " * output,\n\tulong count"
+				+ parameters + "\n) {\n"
+				+ "\tconst size_t i = get_global_id(0);\n"
+				+ "\tif (i < count) output[i] = (" + output.name + ")" + expression + ";\n"
+				+ "}\n";
+		}
+	}
+}
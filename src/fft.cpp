@@ -0,0 +1,89 @@
+#include "fft.hpp"
+#include "exception.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string fftSource(ClTypeInfo const& real) {
+			return real.extensions + "typedef " + real.name + " R;\n"
+				+ "typedef " + real.name + "2 C;\n" + R"(
+inline C cppcl_mul(C a, C b) {
+	return (C)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+inline C cppcl_twiddle(__global const C * twiddles, uint index, int inverse) {
+	const C w = twiddles[index];
+	return (inverse) ? (C)(w.x, -w.y) : w;
+}
+
+// multiplies by -i for forward and by +i for inverse transforms
+inline C cppcl_rotate(C a, int inverse) {
+	return (inverse) ? (C)(-a.y, a.x) : (C)(a.y, -a.x);
+}
+
+__kernel void cppcl_fft_pass(
+	__global const C * input,
+	__global C * output,
+	__global const C * twiddles,
+	uint n,
+	uint stride,
+	uint span,
+	int inverse
+) {
+	const uint j = get_global_id(0);
+	const size_t line = get_global_id(1);
+	const uint quarter = n / RADIX;
+	if (j >= quarter) return;
+	const size_t base = (line / stride) * stride * n + (line % stride);
+	const uint k = j % span;
+	C v[RADIX];
+	for (uint r = 0; r < RADIX; ++r) v[r] = input[base + (size_t)(j + r * quarter) * stride];
+	const uint step = n / (span * RADIX);
+	for (uint r = 1; r < RADIX; ++r) v[r] = cppcl_mul(v[r], cppcl_twiddle(twiddles, k * r * step, inverse));
+#if RADIX == 2
+	const C x0 = v[0] + v[1];
+	const C x1 = v[0] - v[1];
+	v[0] = x0;
+	v[1] = x1;
+#elif RADIX == 4
+	const C a0 = v[0] + v[2];
+	const C a1 = v[0] - v[2];
+	const C a2 = v[1] + v[3];
+	const C a3 = cppcl_rotate(v[1] - v[3], inverse);
+	v[0] = a0 + a2;
+	v[1] = a1 + a3;
+	v[2] = a0 - a2;
+	v[3] = a1 - a3;
+#else
+	C x[RADIX];
+	for (uint q = 0; q < RADIX; ++q) {
+		x[q] = v[0];
+		for (uint r = 1; r < RADIX; ++r) {
+			x[q] += cppcl_mul(v[r], cppcl_twiddle(twiddles, ((r * q) % RADIX) * quarter, inverse));
+		}
+	}
+	for (uint q = 0; q < RADIX; ++q) v[q] = x[q];
+#endif
+	const uint target = (j / span) * span * RADIX + k;
+	for (uint r = 0; r < RADIX; ++r) output[base + (size_t)(target + r * span) * stride] = v[r];
+}
+)";
+		}
+
+		std::vector<size_t> fftRadices(size_t n) {
+			auto radices = std::vector<size_t>{};
+			for (auto radix : {size_t{4}, size_t{2}, size_t{3}, size_t{5}}) {
+				while (n % radix == 0) {
+					radices.push_back(radix);
+					n /= radix;
+				}
+			}
+			if (n != 1) {
+				throw KernelException(
+					ErrorCode::invalid_value,
+					std::string{"fft extents have to factor into the radices 2, 3, 4 and 5."}
+				);
+			}
+			return radices;
+		}
+	}
+}
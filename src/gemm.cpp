@@ -0,0 +1,99 @@
+#include "gemm.hpp"
+
+#include <algorithm>
+
+namespace cl {
+	namespace detail {
+		std::string gemmSource(ClTypeInfo const& type) {
+			return typePreamble(type) + R"(
+#define LOCAL_COLUMNS (TILE / WORK_PER_ITEM)
+
+__kernel void cppcl_gemm(
+	uint m,
+	uint n,
+	uint k,
+	T alpha,
+	__global const T * a,
+	uint lda,
+	__global const T * b,
+	uint ldb,
+	T beta,
+	__global T * c,
+	uint ldc
+) {
+	__local T a_tile[TILE][TILE];
+	__local T b_tile[TILE][TILE];
+	const uint tx = get_local_id(0);
+	const uint ty = get_local_id(1);
+	const uint row = get_group_id(1) * TILE + ty;
+	const uint first_column = get_group_id(0) * TILE;
+	T accumulator[WORK_PER_ITEM];
+	for (uint w = 0; w < WORK_PER_ITEM; ++w) accumulator[w] = (T)0;
+	for (uint t = 0; t < k; t += TILE) {
+		for (uint w = 0; w < WORK_PER_ITEM; ++w) {
+			const uint column = tx + w * LOCAL_COLUMNS;
+			a_tile[ty][column] = (row < m && t + column < k) ? a[row * lda + t + column] : (T)0;
+			b_tile[ty][column] = (t + ty < k && first_column + column < n) ? b[(t + ty) * ldb + first_column + column] : (T)0;
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+		for (uint i = 0; i < TILE; ++i) {
+			const T value = a_tile[ty][i];
+			for (uint w = 0; w < WORK_PER_ITEM; ++w) {
+				accumulator[w] = mad(value, b_tile[i][tx + w * LOCAL_COLUMNS], accumulator[w]);
+			}
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (row >= m) return;
+	for (uint w = 0; w < WORK_PER_ITEM; ++w) {
+		const uint column = first_column + tx + w * LOCAL_COLUMNS;
+		if (column < n) {
+			const T result = alpha * accumulator[w];
+			c[row * ldc + column] = (beta == (T)0) ? result : mad(beta, c[row * ldc + column], result);
+		}
+	}
+}
+
+__kernel void cppcl_gemm_batched(
+	uint m,
+	uint n,
+	uint k,
+	T alpha,
+	__global const T * a,
+	__global const T * b,
+	T beta,
+	__global T * c
+) {
+	const uint column = get_global_id(0);
+	const uint row = get_global_id(1);
+	const size_t batch = get_global_id(2);
+	if (row >= m || column >= n) return;
+	__global const T * a_matrix = a + batch * m * k + row * k;
+	__global const T * b_matrix = b + batch * k * n + column;
+	T accumulator = (T)0;
+	for (uint i = 0; i < k; ++i) accumulator = mad(a_matrix[i], b_matrix[i * n], accumulator);
+	__global T * c_element = c + batch * m * n + row * n + column;
+	*c_element = (beta == (T)0) ? alpha * accumulator : mad(beta, *c_element, alpha * accumulator);
+}
+)";
+		}
+
+		std::string gemmOptions(GemmTiling const& tiling) {
+			return "-D TILE=" + std::to_string(tiling.tile)
+				+ " -D WORK_PER_ITEM=" + std::to_string(tiling.work_per_item);
+		}
+
+		GemmTiling gemmTiling(Device const& device, ScalarType scalar, size_t element_size, size_t max_work_group_size) {
+			const auto local_memory = device.localMemorySize();
+			auto work_per_item = size_t{1};
+			while (work_per_item * 2 <= std::min<size_t>(device.preferredVectorWidth(scalar), 8)) work_per_item *= 2;
+			for (auto tile = size_t{64}; tile > 1; tile /= 2) {
+				const auto work = std::min(work_per_item, tile);
+				const auto fits_local = 2 * tile * tile * element_size <= local_memory / 2;
+				const auto fits_group = tile * tile / work <= max_work_group_size;
+				if (fits_local && fits_group) return {tile, work};
+			}
+			return {1, 1};
+		}
+	}
+}
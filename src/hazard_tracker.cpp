@@ -0,0 +1,111 @@
+#include "hazard_tracker.hpp"
+
+#include <algorithm>
+
+namespace cl {
+	namespace {
+		cl_bool overlaps(size_t begin_a, size_t end_a, size_t begin_b, size_t end_b) {
+			return begin_a < end_b && begin_b < end_a;
+		}
+
+		// Commands that terminated with an error (any negative status) are done as well.
+		cl_bool isComplete(Event const& event) {
+			const auto status = static_cast<cl_int>(event.status());
+			return status == CL_COMPLETE || status < 0;
+		}
+	}
+
+	MemoryAccess HazardTracker::access(
+		MemoryObject const& memory_object,
+		size_t offset,
+		size_t size,
+		AccessMode mode
+	) {
+		const auto parent = memory_object.associatedMemoryObjectId();
+		if (parent == nullptr) {
+			return MemoryAccess{memory_object.id(), offset, offset + size, mode};
+		}
+		const auto origin = memory_object.offsetBytes();
+		return MemoryAccess{parent, origin + offset, origin + offset + size, mode};
+	}
+
+	MemoryAccess HazardTracker::read(MemoryObject const& memory_object) {
+		return access(memory_object, 0, memory_object.size(), AccessMode::read);
+	}
+
+	MemoryAccess HazardTracker::write(MemoryObject const& memory_object) {
+		return access(memory_object, 0, memory_object.size(), AccessMode::write);
+	}
+
+	MemoryAccess HazardTracker::readWrite(MemoryObject const& memory_object) {
+		return access(memory_object, 0, memory_object.size(), AccessMode::read_write);
+	}
+
+	std::vector<Event> HazardTracker::dependencies(std::vector<MemoryAccess> const& accesses) {
+		auto events = std::vector<Event>{};
+		const auto add = [&events](Event const& event) {
+			const auto found = std::find_if(events.begin(), events.end(),
+				[&event](Event const& e) { return e.id() == event.id(); });
+			if (found == events.end()) events.push_back(event);
+		};
+		for (auto&& access : accesses) {
+			const auto it = m_records.find(access.memory_object);
+			if (it == m_records.end()) continue;
+			auto & records = it->second;
+			records.erase(
+				std::remove_if(records.begin(), records.end(),
+					[](Record const& r) { return isComplete(r.event); }),
+				records.end()
+			);
+			const auto writes = access.mode != AccessMode::read;
+			for (auto&& record : records) {
+				if (!overlaps(record.begin, record.end, access.begin, access.end)) continue;
+				if (record.write || writes) add(record.event);
+			}
+		}
+		return events;
+	}
+
+	void HazardTracker::record(std::vector<MemoryAccess> const& accesses, Event const& event) {
+		for (auto&& access : accesses) {
+			auto & records = m_records[access.memory_object];
+			const auto writes = access.mode != AccessMode::read;
+			if (writes) {
+				records.erase(
+					std::remove_if(records.begin(), records.end(), [&access](Record const& r) {
+						return access.begin <= r.begin && r.end <= access.end;
+					}),
+					records.end()
+				);
+			}
+			records.push_back(Record{access.begin, access.end, writes, event});
+		}
+	}
+
+	void HazardTracker::prune() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		for (auto it = m_records.begin(); it != m_records.end();) {
+			auto & records = it->second;
+			records.erase(
+				std::remove_if(records.begin(), records.end(),
+					[](Record const& r) { return isComplete(r.event); }),
+				records.end()
+			);
+			it = (records.empty()) ? m_records.erase(it) : std::next(it);
+		}
+	}
+
+	void HazardTracker::clear() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_records.clear();
+	}
+
+	size_t HazardTracker::countOutstanding() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		auto count = size_t{0};
+		for (auto&& entry : m_records) {
+			count += entry.second.size();
+		}
+		return count;
+	}
+}
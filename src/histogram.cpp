@@ -0,0 +1,88 @@
+#include "histogram.hpp"
+#include "reduce.hpp"
+
+#include <algorithm>
+
+namespace cl {
+	namespace detail {
+		std::string histogramSource(ClTypeInfo const& type) {
+			auto source = typePreamble(type);
+			if (type.is_floating_point) {
+				source += "#define BIN(x) ((uint)min((T)(((x) - lower) * ((T)bins / (upper - lower))), (T)(bins - 1)))\n";
+			} else {
+				source += "#define BIN(x) ((uint)(((ulong)((long)(x) - (long)lower) * bins) / (ulong)((long)upper - (long)lower)))\n";
+			}
+			return source + R"(
+__kernel void cppcl_histogram_clear(__global uint * counts, uint bins) {
+	const size_t i = get_global_id(0);
+	if (i < bins) counts[i] = 0;
+}
+
+__kernel void cppcl_histogram_global(
+	__global const T * input,
+	ulong count,
+	uint bins,
+	T lower,
+	T upper,
+	__global uint * counts
+) {
+	for (size_t i = get_global_id(0); i < count; i += get_global_size(0)) {
+		const T x = input[i];
+		if (x >= lower && x < upper) atomic_inc(&counts[BIN(x)]);
+	}
+}
+
+__kernel void cppcl_histogram_local(
+	__global const T * input,
+	ulong count,
+	uint bins,
+	T lower,
+	T upper,
+	uint copies,
+	uint chunk,
+	__global uint * counts,
+	__local uint * local_counts
+) {
+	const uint lid = get_local_id(0);
+	const uint n = get_local_size(0);
+	const uint first_bin = get_group_id(1) * chunk;
+	const uint chunk_bins = min(chunk, bins - first_bin);
+	for (uint j = lid; j < copies * chunk; j += n) local_counts[j] = 0;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	__local uint * private_counts = local_counts + (lid % copies) * chunk;
+	for (size_t i = get_global_id(0); i < count; i += get_global_size(0)) {
+		const T x = input[i];
+		if (x >= lower && x < upper) {
+			const uint bin = BIN(x) - first_bin;
+			if (bin < chunk_bins) atomic_inc(&private_counts[bin]);
+		}
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (uint b = lid; b < chunk_bins; b += n) {
+		uint sum = 0;
+		for (uint c = 0; c < copies; ++c) sum += local_counts[c * chunk + b];
+		if (sum) atomic_add(&counts[first_bin + b], sum);
+	}
+}
+)";
+		}
+
+		HistogramStrategy histogramStrategy(Device const& device, Kernel const& kernel, size_t count, size_t bins) {
+			const auto max_copies = size_t{8};
+			const auto max_chunks = size_t{4};
+			auto strategy = HistogramStrategy{false, reduceWorkGroupSize(device, kernel, 1), 1, 1, bins, 1};
+			const auto groups = (count + strategy.local_size - 1) / strategy.local_size;
+			strategy.groups = std::max(std::min(groups, size_t{4} * device.maxComputeUnits()), size_t{1});
+			if (device.localMemoryType() != DeviceLocalMemoryType::local) return strategy;
+			const auto local_memory = device.localMemorySize();
+			const auto used_memory = kernel.localMemorySize(device);
+			const auto capacity = (local_memory > used_memory) ? (local_memory - used_memory) / sizeof(cl_uint) : 0;
+			if (capacity == 0 || bins > max_chunks * capacity) return strategy;
+			strategy.privatized = true;
+			strategy.chunk = std::min(bins, static_cast<size_t>(capacity));
+			strategy.chunks = (bins + strategy.chunk - 1) / strategy.chunk;
+			strategy.copies = std::max(std::min({capacity / strategy.chunk, max_copies, strategy.local_size}), size_t{1});
+			return strategy;
+		}
+	}
+}
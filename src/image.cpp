@@ -1,113 +1,104 @@
 #include "image.hpp"
+#include "error_handler.hpp"
 
-namespace cl {
-
-}
-
-/*
-class MemoryObject
-
-class Image extends MemoryObject
-
-class Image1D extends Image (OpenCL 1.2)
-    Image1D(
-        const Context& context,
-        cl_mem_flags flags,
-        ImageFormat format,
-        ::size_t width,
-        void* host_ptr = NULL,
-        cl_int* err = NULL
-	)
+#include <memory>
 
-class Image1DBuffer extends Image (OpenCL 1.2)
-    Image1DBuffer(
-        const Context& context,
-        cl_mem_flags flags,
-        ImageFormat format,
-        ::size_t width,
-        const Buffer &buffer,
-        cl_int* err = NULL
-	)
-
-class Image1DArray extends Image (OpenCL 1.2)
-    Image1DArray(
-        const Context& context,
-        cl_mem_flags flags,
-        ImageFormat format,
-        ::size_t arraySize,
-        ::size_t width,
-        ::size_t rowPitch,
-        void* host_ptr = NULL,
-        cl_int* err = NULL
-	)
-
-class Image2D extends Image (OpenCL 1.0)
-    Image2D(
-        const Context& context,
-        cl_mem_flags flags,
-        ImageFormat format,
-        ::size_t width,
-        ::size_t height,
-        ::size_t row_pitch = 0,
-        void* host_ptr = NULL,
-        cl_int* err = NULL
-	)
-
-class Image2DGL extends Image (OpenCL <1.2 [deprecated for ImageGL])
-    Image2DGL(
-        const Context& context,
-        cl_mem_flags flags,
-        GLenum target,
-        GLint  miplevel,
-        GLuint texobj,
-        cl_int * err = NULL
-	)
-
-class Image2DArray extends Image (OpenCL 1.2)
-    Image2DArray(
-        const Context& context,
-        cl_mem_flags flags,
-        ImageFormat format,
-        ::size_t arraySize,
-        ::size_t width,
-        ::size_t height,
-        ::size_t rowPitch,
-        ::size_t slicePitch,
-        void* host_ptr = NULL,
-        cl_int* err = NULL
-	)
+namespace cl {
+	namespace detail {
+		cl_mem createImage(
+			Context const& context,
+			MemoryFlags const& flags,
+			cl_image_format const& format,
+			ImageDescription const& description,
+			void * host_ptr
+		) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_context, "the given context is invalid."},
+				{ErrorCode::invalid_value, "the given memory flags are invalid."},
+				{ErrorCode::invalid_image_format_descriptor, "the given image format is invalid."},
+				{ErrorCode::invalid_image_size, "the given image dimensions exceed the maximum image dimensions of all devices of the given context."},
+				{ErrorCode::invalid_host_ptr, "invalid use of host pointer parameter and associated memory flags; OR the given pitches do not match the image dimensions."},
+				{ErrorCode::image_format_not_supported, "the given image format is not supported by the given context."},
+				{ErrorCode::memory_object_allocation_failure, "there was a failure to allocate memory for the image object."},
+				{ErrorCode::invalid_operation, "there is no device in the given context which supports images."}
+			};
+			if (!ImageFormatCache::supports(context, flags, description.type, format)) {
+				throw MemoryObjectException(ErrorCode::image_format_not_supported,
+					std::string{error_map.at(ErrorCode::image_format_not_supported)});
+			}
+			auto error = cl_int{CL_SUCCESS};
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+			auto desc = cl_image_desc{};
+			desc.image_type = static_cast<cl_mem_object_type>(description.type);
+			desc.image_width = description.width;
+			desc.image_height = description.height;
+			desc.image_depth = description.depth;
+			desc.image_array_size = description.array_size;
+			desc.image_row_pitch = description.row_pitch;
+			desc.image_slice_pitch = description.slice_pitch;
+			desc.num_mip_levels = 0;
+			desc.num_samples = 0;
+			desc.buffer = description.buffer;
+			auto image_id = clCreateImage(
+				context.id(), flags.mask(), std::addressof(format), std::addressof(desc), host_ptr, std::addressof(error));
+#else
+			auto image_id = (description.type == MemoryObjectType::image3d)
+				? clCreateImage3D(
+					context.id(), flags.mask(), std::addressof(format),
+					description.width, description.height, description.depth,
+					description.row_pitch, description.slice_pitch, host_ptr, std::addressof(error))
+				: clCreateImage2D(
+					context.id(), flags.mask(), std::addressof(format),
+					description.width, description.height,
+					description.row_pitch, host_ptr, std::addressof(error));
+#endif
+			error::handle<MemoryObjectException>(error, error_map);
+			return image_id;
+		}
 
-class Image3D extends Image (OpenCL 1.0)
-    Image3D(
-        const Context& context,
-        cl_mem_flags flags,
-        ImageFormat format,
-        ::size_t width,
-        ::size_t height,
-        ::size_t depth,
-        ::size_t row_pitch = 0,
-        ::size_t slice_pitch = 0,
-        void* host_ptr = NULL,
-        cl_int* err = NULL
-	)
+		size_t imageInfoSize(cl_mem image, cl_image_info info_id) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_memory_object, "the given image object is invalid."},
+				{ErrorCode::invalid_value, "invalid use of getImageInfo function; OR invalid information queried."}
+			};
+			auto info = size_t{0};
+			auto error = clGetImageInfo(image, info_id, sizeof(size_t), std::addressof(info), nullptr);
+			error::handle<MemoryObjectException>(error, error_map);
+			return info;
+		}
 
-class Image3DGL extends Image (OpenCL v1.2)
-    Image3DGL(
-        const Context& context,
-        cl_mem_flags flags,
-        GLenum target,
-        GLint  miplevel,
-        GLuint texobj,
-        cl_int * err = NULL
-	)
+		cl_image_format imageInfoFormat(cl_mem image) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_memory_object, "the given image object is invalid."}
+			};
+			auto format = cl_image_format{};
+			auto error = clGetImageInfo(image, CL_IMAGE_FORMAT, sizeof(cl_image_format), std::addressof(format), nullptr);
+			error::handle<MemoryObjectException>(error, error_map);
+			return format;
+		}
 
-class ImageGL extends Image (OpenCL v1.2)
-	ImageGL(
-		const Context& context,
-		cl_mem_flags flags,
-		GLenum target,
-		GLint  miplevel,
-		GLuint texobj,
-		cl_int * err = NULL
-	)
-*/
+		std::array<size_t, 3> imageRegion(cl_mem image) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_memory_object, "the given image object is invalid."}
+			};
+			auto type = cl_mem_object_type{};
+			auto error = clGetMemObjectInfo(image, CL_MEM_TYPE, sizeof(cl_mem_object_type), std::addressof(type), nullptr);
+			error::handle<MemoryObjectException>(error, error_map);
+			const auto width = imageInfoSize(image, CL_IMAGE_WIDTH);
+			switch (static_cast<MemoryObjectType>(type)) {
+				case MemoryObjectType::image2d:
+					return {{width, imageInfoSize(image, CL_IMAGE_HEIGHT), 1}};
+				case MemoryObjectType::image3d:
+					return {{width, imageInfoSize(image, CL_IMAGE_HEIGHT), imageInfoSize(image, CL_IMAGE_DEPTH)}};
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+				case MemoryObjectType::image1d_array:
+					return {{width, imageInfoSize(image, CL_IMAGE_ARRAY_SIZE), 1}};
+				case MemoryObjectType::image2d_array:
+					return {{width, imageInfoSize(image, CL_IMAGE_HEIGHT), imageInfoSize(image, CL_IMAGE_ARRAY_SIZE)}};
+#endif
+				default:
+					return {{width, 1, 1}};
+			}
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#include "image_format.hpp"
+#include "error_handler.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace cl {
+	namespace {
+		using CacheKey = std::tuple<cl_context, cl_mem_flags, cl_mem_object_type>;
+
+		// Entries hold a reference to their context, so its handle cannot be
+		// reused by a new context while the entry exists (like ProgramCache).
+		struct CacheEntry final {
+			Context context;
+			std::vector<cl_image_format> formats;
+		};
+
+		std::mutex cache_mutex;
+		std::map<CacheKey, CacheEntry> cache;
+
+		// Only the access qualifiers decide about supported formats;
+		// host pointer flags would otherwise split the cache needlessly.
+		cl_mem_flags accessFlags(MemoryFlags const& flags) {
+			return flags.mask() & (CL_MEM_READ_WRITE | CL_MEM_READ_ONLY | CL_MEM_WRITE_ONLY);
+		}
+	}
+
+	std::vector<cl_image_format> ImageFormatCache::get(
+		Context const& context, MemoryFlags const& flags, MemoryObjectType type
+	) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_context, "the given context is invalid."},
+			{ErrorCode::invalid_value, "the given memory flags or image type are invalid."}
+		};
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		auto key = CacheKey{context.id(), accessFlags(flags), static_cast<cl_mem_object_type>(type)};
+		const auto found = cache.find(key);
+		if (found != cache.end()) return found->second.formats;
+		auto count = cl_uint{0};
+		auto error = clGetSupportedImageFormats(
+			context.id(), std::get<1>(key), std::get<2>(key), 0, nullptr, std::addressof(count));
+		error::handle<ContextException>(error, error_map);
+		auto formats = std::vector<cl_image_format>(count);
+		if (count > 0) {
+			error = clGetSupportedImageFormats(
+				context.id(), std::get<1>(key), std::get<2>(key), count, formats.data(), nullptr);
+			error::handle<ContextException>(error, error_map);
+		}
+		cache.emplace(std::move(key), CacheEntry{context, formats});
+		return formats;
+	}
+
+	bool ImageFormatCache::supports(
+		Context const& context, MemoryFlags const& flags, MemoryObjectType type, cl_image_format const& format
+	) {
+		const auto formats = get(context, flags, type);
+		return std::any_of(formats.begin(), formats.end(), [&](cl_image_format const& supported) {
+			return supported.image_channel_order == format.image_channel_order
+				&& supported.image_channel_data_type == format.image_channel_data_type;
+		});
+	}
+
+	void ImageFormatCache::clear() {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		cache.clear();
+	}
+}
@@ -0,0 +1,128 @@
+#include "kernel.hpp"
+#include "sampler.hpp"
+#include "error_handler.hpp"
+
+#include <algorithm>
+
+namespace cl {
+	const error::ErrorMap KernelInfo::error_map = {
+		{ErrorCode::invalid_kernel, "the given kernel is invalid."}
+	};
+
+	Kernel::Kernel(cl_kernel kernel_id) :
+		Object{kernel_id}
+	{}
+
+	Kernel::Kernel(Program const& program, std::string const& name) :
+		Object{}
+	{
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_program, "the given program is invalid."},
+			{ErrorCode::invalid_program_executable, "there is no successfully built executable for the given program."},
+			{ErrorCode::invalid_kernel_name, "the given kernel name was not found in the program."},
+			{ErrorCode::invalid_kernel_definition, "the function definition of the kernel differs between the devices of the program."},
+			{ErrorCode::invalid_value, "the given kernel name is empty."}
+		};
+		auto error = cl_int{CL_INVALID_VALUE};
+		auto new_id = clCreateKernel(program.id(), name.c_str(), std::addressof(error));
+		if (error::handle<KernelException>(error, error_map)) m_id = new_id;
+	}
+
+	void Kernel::setArgRaw(cl_uint index, size_t size, const void * value) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_kernel, "this kernel is invalid."},
+			{ErrorCode::invalid_argument_index, "the given argument index is out of range."},
+			{ErrorCode::invalid_argument_value, "the given argument value is invalid; OR a local memory argument was given a value."},
+			{ErrorCode::invalid_memory_object, "the given memory object argument is invalid."},
+			{ErrorCode::invalid_sampler, "the given sampler argument is invalid."},
+			{ErrorCode::invalid_argument_size, "the size of the given argument does not match the kernel parameter; OR local memory of size zero was requested."}
+		};
+		error::handle<KernelException>(clSetKernelArg(m_id, index, size, value), error_map);
+	}
+
+	void Kernel::setArg(cl_uint index, Sampler const& sampler) {
+		const auto sampler_id = sampler.id();
+		setArgRaw(index, sizeof(cl_sampler), std::addressof(sampler_id));
+	}
+
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	void Kernel::setArgSvmPointer(cl_uint index, const void * svm_pointer) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_kernel, "this kernel is invalid."},
+			{ErrorCode::invalid_argument_index, "the given argument index is out of range."},
+			{ErrorCode::invalid_argument_value, "the given pointer is not a valid shared virtual memory pointer."}
+		};
+		error::handle<KernelException>(clSetKernelArgSVMPointer(m_id, index, svm_pointer), error_map);
+	}
+
+	void Kernel::setIndirectSvmPointers(std::vector<const void*> const& svm_pointers) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_kernel, "this kernel is invalid."},
+			{ErrorCode::invalid_value, "the given pointers are invalid."},
+			{ErrorCode::invalid_operation, "no device of the context of this kernel supports shared virtual memory."}
+		};
+		error::handle<KernelException>(
+			clSetKernelExecInfo(
+				m_id, CL_KERNEL_EXEC_INFO_SVM_PTRS,
+				svm_pointers.size() * sizeof(const void*),
+				(svm_pointers.empty()) ? nullptr : svm_pointers.data()
+			),
+			error_map
+		);
+	}
+#endif
+
+	template <typename T>
+	T Kernel::getWorkGroupInfo(Device const& device, cl_kernel_work_group_info info_id) const {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_device, "the given device is not associated with this kernel."},
+			{ErrorCode::invalid_value, "invalid use of getWorkGroupInfo function; OR invalid information queried."}
+		};
+		auto info = T{};
+		auto error = clGetKernelWorkGroupInfo(
+			m_id, device.id(), info_id, sizeof(T), std::addressof(info), nullptr);
+		error::handle<KernelException>(error, error_map);
+		return info;
+	}
+
+	std::string Kernel::functionName() const {
+		auto name = getInfoString(CL_KERNEL_FUNCTION_NAME);
+		return {name.begin(), std::find(name.begin(), name.end(), '\0')};
+	}
+
+	cl_uint Kernel::numArgs() const {
+		return getInfo<cl_uint>(CL_KERNEL_NUM_ARGS);
+	}
+
+	cl_uint Kernel::referenceCount() const {
+		return getInfo<cl_uint>(CL_KERNEL_REFERENCE_COUNT);
+	}
+
+	Context Kernel::context() const {
+		const auto context_id = getInfo<cl_context>(CL_KERNEL_CONTEXT);
+		ContextInfo::func_retain(context_id);
+		return {context_id};
+	}
+
+	Program Kernel::program() const {
+		const auto program_id = getInfo<cl_program>(CL_KERNEL_PROGRAM);
+		ProgramInfo::func_retain(program_id);
+		return {program_id};
+	}
+
+	size_t Kernel::workGroupSize(Device const& device) const {
+		return getWorkGroupInfo<size_t>(device, CL_KERNEL_WORK_GROUP_SIZE);
+	}
+
+	size_t Kernel::preferredWorkGroupSizeMultiple(Device const& device) const {
+		return getWorkGroupInfo<size_t>(device, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE);
+	}
+
+	cl_ulong Kernel::localMemorySize(Device const& device) const {
+		return getWorkGroupInfo<cl_ulong>(device, CL_KERNEL_LOCAL_MEM_SIZE);
+	}
+
+	cl_ulong Kernel::privateMemorySize(Device const& device) const {
+		return getWorkGroupInfo<cl_ulong>(device, CL_KERNEL_PRIVATE_MEM_SIZE);
+	}
+}
@@ -0,0 +1,66 @@
+#include "lookup_table.hpp"
+
+namespace cl {
+	namespace detail {
+		LookupTableStorage lookupTableStorage(
+			CommandQueue const& queue,
+			size_t count_elements,
+			size_t size_bytes,
+			cl_bool image_format_available,
+			cl_image_format const& format
+		) {
+			const auto device = queue.device();
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+			if (image_format_available
+				&& device.imageSupport()
+				&& count_elements <= device.maxBufferSizeImage1D()
+				&& ImageFormatCache::supports(
+					queue.context(), MemoryFlags{CL_MEM_READ_ONLY}, MemoryObjectType::image1d_buffer, format)
+			) {
+				return LookupTableStorage::image;
+			}
+#else
+			(void)count_elements;
+			(void)image_format_available;
+			(void)format;
+#endif
+			if (size_bytes <= device.maxConstantBufferSize()) {
+				return LookupTableStorage::constant;
+			}
+			return LookupTableStorage::global;
+		}
+
+		std::string lookupTablePreamble(
+			LookupTableStorage storage,
+			ClTypeInfo const& type,
+			ChannelType channel_type,
+			std::string const& name
+		) {
+			auto source = type.extensions;
+			source +=
+				"#ifndef CPPCL_LOOKUP_TABLE\n"
+				"#define CPPCL_LOOKUP_TABLE(name) CPPCL_LOOKUP_TABLE_##name\n"
+				"#define CPPCL_LOOKUP(name, index) CPPCL_LOOKUP_##name(index)\n"
+				"#endif\n";
+			switch (storage) {
+				case LookupTableStorage::image: {
+					const auto read = (channel_type == ChannelType::t_float) ? "read_imagef"
+						: (type.is_signed) ? "read_imagei" : "read_imageui";
+					source += "#define CPPCL_LOOKUP_TABLE_" + name + " __read_only image1d_buffer_t " + name + "\n";
+					source += "#define CPPCL_LOOKUP_" + name + "(index) ((" + type.name + ")"
+						+ read + "(" + name + ", (int)(index)).x)\n";
+					break;
+				}
+				case LookupTableStorage::constant:
+					source += "#define CPPCL_LOOKUP_TABLE_" + name + " __constant " + type.name + " const* " + name + "\n";
+					source += "#define CPPCL_LOOKUP_" + name + "(index) (" + name + "[(index)])\n";
+					break;
+				case LookupTableStorage::global:
+					source += "#define CPPCL_LOOKUP_TABLE_" + name + " __global " + type.name + " const* restrict " + name + "\n";
+					source += "#define CPPCL_LOOKUP_" + name + "(index) (" + name + "[(index)])\n";
+					break;
+			}
+			return source;
+		}
+	}
+}
@@ -4,6 +4,7 @@
 #include "wrapper.hpp"
 #include "platform.hpp"
 #include "device.hpp"
+#include "device_selector.hpp"
 #include "context.hpp"
 #include "context_properties.hpp"
 #include "error_handler.hpp"
@@ -30,7 +31,12 @@ int main(int, const char**) {
 
 	auto devices = platform.getDevices(cl::DeviceType::all);
 	std::cout << "Count devices: " << devices.size() << '\n';
-	auto device = devices[0];
+	auto device = devices.front();
+	try {
+		device = cl::DeviceSelector::best(devices);
+	} catch (cl::Exception const& e) {
+		std::cout << "Device selection failed, using the first device: " << e.what() << '\n';
+	}
 	std::cout << "Devices ...\n"
 			  << "\tName: " << device.name() << '\n'
 			  << "\tAvailable: " << device.available() << '\n'
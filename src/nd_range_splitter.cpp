@@ -0,0 +1,112 @@
+#include "nd_range_splitter.hpp"
+#include "device.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cassert>
+
+namespace cl {
+	NDRangeSplitter::NDRangeSplitter(std::vector<CommandQueue> const& queues, double smoothing) :
+		m_queues{queues},
+		m_profiling{},
+		m_measured(queues.size(), false),
+		m_throughput{},
+		m_pending{},
+		m_smoothing{smoothing}
+	{
+		assert(!queues.empty());
+		assert(smoothing > 0.0 && smoothing <= 1.0);
+		for (auto&& queue : m_queues) {
+			const auto device = queue.device();
+			m_profiling.push_back((queue.properties().mask() & CL_QUEUE_PROFILING_ENABLE) != 0);
+			m_throughput.push_back(
+				static_cast<double>(device.maxComputeUnits()) *
+				static_cast<double>(std::max(device.maxClockFrequency(), cl_uint{1})));
+		}
+	}
+
+	std::vector<NDRangeSlice> NDRangeSplitter::split(size_t global_size, size_t granularity) const {
+		assert(granularity > 0);
+		const auto count_units = global_size / granularity;
+		const auto total = std::accumulate(m_throughput.begin(), m_throughput.end(), 0.0);
+		auto units = std::vector<size_t>(m_queues.size(), 0);
+		auto remainders = std::vector<std::pair<double, size_t>>{};
+		auto assigned = size_t{0};
+		for (auto i = size_t{0}; i < m_queues.size(); ++i) {
+			const auto share = static_cast<double>(count_units) * m_throughput[i] / total;
+			units[i] = static_cast<size_t>(share);
+			assigned += units[i];
+			remainders.emplace_back(share - static_cast<double>(units[i]), i);
+		}
+		std::sort(remainders.begin(), remainders.end(), std::greater<std::pair<double, size_t>>{});
+		for (auto i = size_t{0}; assigned < count_units; ++i, ++assigned) {
+			++units[remainders[i % remainders.size()].second];
+		}
+		auto slices = std::vector<NDRangeSlice>{};
+		auto offset = size_t{0};
+		for (auto i = size_t{0}; i < m_queues.size(); ++i) {
+			if (units[i] == 0) continue;
+			slices.push_back(NDRangeSlice{i, offset, units[i] * granularity});
+			offset += units[i] * granularity;
+		}
+		if (offset < global_size) {
+			if (slices.empty()) {
+				const auto fastest = std::max_element(m_throughput.begin(), m_throughput.end());
+				slices.push_back(NDRangeSlice{
+					static_cast<size_t>(std::distance(m_throughput.begin(), fastest)), 0, 0});
+			}
+			slices.back().size += global_size - offset;
+		}
+		return slices;
+	}
+
+	void NDRangeSplitter::record(NDRangeSlice const& slice, Event const& event) {
+		if (m_profiling[slice.queue_index]) {
+			m_pending.push_back(Launch{slice.queue_index, slice.size, event});
+		}
+	}
+
+	void NDRangeSplitter::update() {
+		auto still_pending = std::vector<Launch>{};
+		for (auto&& launch : m_pending) {
+			const auto status = launch.event.status();
+			if (status == CommandExecutionStatus::error) continue;
+			if (status != CommandExecutionStatus::complete) {
+				still_pending.push_back(launch);
+				continue;
+			}
+			const auto start = launch.event.profilingCommandStart();
+			const auto end = launch.event.profilingCommandEnd();
+			const auto measured =
+				static_cast<double>(launch.size) / static_cast<double>(std::max(end - start, cl_ulong{1}));
+			const auto i = launch.queue_index;
+			if (!m_measured[i]) {
+				if (std::none_of(m_measured.begin(), m_measured.end(), [](cl_bool m) { return m; })) {
+					const auto scale = measured / m_throughput[i];
+					for (auto&& throughput : m_throughput) throughput *= scale;
+				}
+				m_throughput[i] = measured;
+				m_measured[i] = true;
+			} else {
+				m_throughput[i] = (1.0 - m_smoothing) * m_throughput[i] + m_smoothing * measured;
+			}
+		}
+		m_pending = std::move(still_pending);
+	}
+
+	void NDRangeSplitter::synchronize() {
+		for (auto&& queue : m_queues) {
+			queue.finish();
+		}
+		update();
+	}
+
+	std::vector<double> NDRangeSplitter::throughputs() const {
+		return m_throughput;
+	}
+
+	std::vector<CommandQueue> const& NDRangeSplitter::queues() const {
+		return m_queues;
+	}
+}
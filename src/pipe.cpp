@@ -0,0 +1,72 @@
+#include "pipe.hpp"
+#include "device.hpp"
+#include "error_handler.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace cl {
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	namespace detail {
+		cl_mem createPipe(Context const& context, size_t packet_size, cl_uint max_packets) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_context, "the given context is invalid."},
+				{ErrorCode::invalid_value, "the given memory flags are invalid."},
+				{ErrorCode::invalid_pipe_size, "the packet size exceeds the maximum packet size of a device of the given context; OR the pipe capacity is zero or exceeds the maximum allocation size."},
+				{ErrorCode::memory_object_allocation_failure, "there was a failure to allocate memory for the pipe object."}
+			};
+			const auto capacity = static_cast<cl_ulong>(packet_size) * max_packets;
+			for (auto&& device : context.devices()) {
+				if (max_packets == 0
+					|| packet_size > device.pipeMaxPacketSize()
+					|| capacity > device.maxMemoryAllocationSize()
+				) {
+					throw MemoryObjectException(ErrorCode::invalid_pipe_size,
+						std::string{error_map.at(ErrorCode::invalid_pipe_size)});
+				}
+			}
+			auto error = cl_int{CL_SUCCESS};
+			auto pipe_id = clCreatePipe(
+				context.id(), 0, static_cast<cl_uint>(packet_size), max_packets, nullptr, std::addressof(error));
+			error::handle<MemoryObjectException>(error, error_map);
+			return pipe_id;
+		}
+
+		cl_uint pipeInfo(cl_mem pipe, cl_pipe_info info_id) {
+			static const auto error_map = error::ErrorMap{
+				{ErrorCode::invalid_memory_object, "the given memory object is not a valid pipe."},
+				{ErrorCode::invalid_value, "invalid pipe information queried."}
+			};
+			auto info = cl_uint{0};
+			error::handle<MemoryObjectException>(
+				clGetPipeInfo(pipe, info_id, sizeof(cl_uint), std::addressof(info), nullptr), error_map);
+			return info;
+		}
+	}
+
+	std::vector<Event> launchPipeline(
+		std::vector<PipeStage> const& stages,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		auto queue_ids = std::vector<cl_command_queue>{};
+		for (auto&& stage : stages) {
+			if (std::find(queue_ids.begin(), queue_ids.end(), stage.queue.id()) != queue_ids.end()) {
+				throw CommandQueueException(ErrorCode::invalid_command_queue,
+					std::string{"pipeline stages have to be launched on distinct command queues."});
+			}
+			queue_ids.push_back(stage.queue.id());
+		}
+		auto events = std::vector<Event>{};
+		for (auto&& stage : stages) {
+			auto queue = stage.queue;
+			events.push_back(queue.enqueueNDRangeKernel(
+				stage.kernel, 0, stage.global_size, stage.local_size, events_in_wait_list));
+		}
+		for (auto&& stage : stages) {
+			auto queue = stage.queue;
+			queue.flush();
+		}
+		return events;
+	}
+#endif
+}
@@ -0,0 +1,145 @@
+#include "program.hpp"
+#include "error_handler.hpp"
+
+#include <algorithm>
+
+namespace cl {
+	const error::ErrorMap ProgramInfo::error_map = {
+		{ErrorCode::invalid_program, "the given program is invalid."}
+	};
+
+	Program::Program(cl_program program_id) :
+		Object{program_id}
+	{}
+
+	Program::Program(Context const& context, std::string const& source) :
+		Program{context, std::vector<std::string>{source}}
+	{}
+
+	Program::Program(Context const& context, std::vector<std::string> const& sources) :
+		Object{}
+	{
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_context, "the given context is invalid."},
+			{ErrorCode::invalid_value, "no sources were given; OR any of the given sources is empty."}
+		};
+		auto strings = std::vector<const char*>{};
+		auto lengths = std::vector<size_t>{};
+		for (auto&& source : sources) {
+			strings.push_back(source.c_str());
+			lengths.push_back(source.size());
+		}
+		auto error = cl_int{CL_INVALID_VALUE};
+		auto new_id = clCreateProgramWithSource(
+			context.id(),
+			strings.size(),
+			strings.data(),
+			lengths.data(),
+			std::addressof(error)
+		);
+		if (error::handle<ProgramException>(error, error_map)) m_id = new_id;
+	}
+
+	template <typename T>
+	T Program::getBuildInfo(Device const& device, cl_program_build_info info_id) const {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_device, "the given device is not associated with this program."},
+			{ErrorCode::invalid_value, "invalid use of getBuildInfo function; OR invalid information queried."}
+		};
+		auto info = T{};
+		auto error = clGetProgramBuildInfo(
+			m_id, device.id(), info_id, sizeof(T), std::addressof(info), nullptr);
+		error::handle<ProgramException>(error, error_map);
+		return info;
+	}
+
+	std::string Program::getBuildInfoString(Device const& device, cl_program_build_info info_id) const {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_device, "the given device is not associated with this program."},
+			{ErrorCode::invalid_value, "invalid use of getBuildInfo function; OR invalid information queried."}
+		};
+		auto buffer_size = size_t{0};
+		auto error = clGetProgramBuildInfo(
+			m_id, device.id(), info_id, 0, nullptr, std::addressof(buffer_size));
+		error::handle<ProgramException>(error, error_map);
+		auto info = std::vector<char>(buffer_size);
+		error = clGetProgramBuildInfo(
+			m_id, device.id(), info_id, buffer_size, info.data(), nullptr);
+		error::handle<ProgramException>(error, error_map);
+		return {info.begin(), std::find(info.begin(), info.end(), '\0')};
+	}
+
+	void Program::build(std::vector<Device> const& devices, std::string const& options) {
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_program, "this program is invalid."},
+			{ErrorCode::invalid_device, "one or more of the given devices are not associated with this program."},
+			{ErrorCode::invalid_binary, "one or more of the given devices have no valid program binary loaded."},
+			{ErrorCode::invalid_build_options, "the given build options are invalid."},
+			{ErrorCode::compiler_not_available, "there is no compiler available for this program."},
+			{ErrorCode::build_program_failure, "failed to build the program executable."},
+			{ErrorCode::invalid_operation, "a previous build of this program has not yet completed; OR there are kernel objects attached to this program."}
+		};
+		const auto error = clBuildProgram(
+			m_id,
+			devices.size(),
+			(devices.empty()) ? nullptr : reinterpret_cast<const cl_device_id*>(devices.data()),
+			options.c_str(),
+			nullptr,
+			nullptr
+		);
+		if (error == CL_BUILD_PROGRAM_FAILURE) {
+			auto log = std::string{error_map.at(ErrorCode::build_program_failure)};
+			for (auto&& device : (devices.empty()) ? this->devices() : devices) {
+				if (buildStatus(device) == BuildStatus::error) {
+					log += "\n" + device.name() + ":\n" + buildLog(device);
+				}
+			}
+			throw ProgramException(ErrorCode::build_program_failure, log);
+		}
+		error::handle<ProgramException>(error, error_map);
+	}
+
+	void Program::build(std::string const& options) {
+		build(std::vector<Device>{}, options);
+	}
+
+	BuildStatus Program::buildStatus(Device const& device) const {
+		return static_cast<BuildStatus>(getBuildInfo<cl_build_status>(device, CL_PROGRAM_BUILD_STATUS));
+	}
+
+	std::string Program::buildOptions(Device const& device) const {
+		return getBuildInfoString(device, CL_PROGRAM_BUILD_OPTIONS);
+	}
+
+	std::string Program::buildLog(Device const& device) const {
+		return getBuildInfoString(device, CL_PROGRAM_BUILD_LOG);
+	}
+
+	cl_uint Program::referenceCount() const {
+		return getInfo<cl_uint>(CL_PROGRAM_REFERENCE_COUNT);
+	}
+
+	Context Program::context() const {
+		const auto context_id = getInfo<cl_context>(CL_PROGRAM_CONTEXT);
+		ContextInfo::func_retain(context_id);
+		return {context_id};
+	}
+
+	cl_uint Program::numDevices() const {
+		return getInfo<cl_uint>(CL_PROGRAM_NUM_DEVICES);
+	}
+
+	std::vector<Device> Program::devices() const {
+		auto device_ids = getInfoVector<cl_device_id>(CL_PROGRAM_DEVICES);
+		auto devices = std::vector<Device>();
+		for (auto&& device_id : device_ids) {
+			devices.emplace_back(device_id);
+		}
+		return devices;
+	}
+
+	std::string Program::source() const {
+		auto source = getInfoString(CL_PROGRAM_SOURCE);
+		return {source.begin(), std::find(source.begin(), source.end(), '\0')};
+	}
+}
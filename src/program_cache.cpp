@@ -0,0 +1,30 @@
+#include "program_cache.hpp"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace cl {
+	namespace {
+		using CacheKey = std::tuple<cl_context, std::string, std::string>;
+
+		std::mutex cache_mutex;
+		std::map<CacheKey, Program> cache;
+	}
+
+	Program ProgramCache::get(Context const& context, std::string const& source, std::string const& options) {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		auto key = CacheKey{context.id(), source, options};
+		const auto found = cache.find(key);
+		if (found != cache.end()) return found->second;
+		auto program = Program{context, source};
+		program.build(options);
+		cache.emplace(std::move(key), program);
+		return program;
+	}
+
+	void ProgramCache::clear() {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		cache.clear();
+	}
+}
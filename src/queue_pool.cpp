@@ -0,0 +1,112 @@
+#include "queue_pool.hpp"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace cl {
+	namespace {
+		std::atomic<uint64_t> next_pool_id{0};
+
+		// Pool ids are never reused, so entries of destroyed pools never match a lookup;
+		// they are pruned against the live pools whenever a thread registers a new queue.
+		std::mutex live_pools_mutex;
+		std::set<uint64_t> live_pools;
+
+		thread_local std::vector<std::pair<uint64_t, CommandQueue*>> thread_queues;
+
+		void pruneThreadQueues() {
+			std::lock_guard<std::mutex> lock{live_pools_mutex};
+			thread_queues.erase(
+				std::remove_if(thread_queues.begin(), thread_queues.end(),
+					[](std::pair<uint64_t, CommandQueue*> const& entry) {
+						return live_pools.count(entry.first) == 0;
+					}),
+				thread_queues.end());
+		}
+	}
+
+	QueuePool::QueuePool(
+		Context const& context,
+		Device const& device,
+		CommandQueueProperties const& properties,
+		size_t count_shards
+	) :
+		m_context{context},
+		m_device{device},
+		m_properties{properties},
+		m_count_shards{count_shards},
+		m_pool_id{next_pool_id++},
+		m_mutex{},
+		m_queues{},
+		m_next_shard{0}
+	{
+		std::lock_guard<std::mutex> lock{live_pools_mutex};
+		live_pools.insert(m_pool_id);
+	}
+
+	QueuePool::~QueuePool() {
+		std::lock_guard<std::mutex> lock{live_pools_mutex};
+		live_pools.erase(m_pool_id);
+	}
+
+	CommandQueue & QueuePool::acquire() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		if (m_count_shards == 0 || m_queues.size() < m_count_shards) {
+			m_queues.emplace_back(m_context, m_device, m_properties);
+			return m_queues.back();
+		}
+		auto & queue = m_queues[m_next_shard];
+		m_next_shard = (m_next_shard + 1) % m_count_shards;
+		return queue;
+	}
+
+	CommandQueue & QueuePool::local() {
+		for (auto&& entry : thread_queues) {
+			if (entry.first == m_pool_id) return * entry.second;
+		}
+		pruneThreadQueues();
+		auto & queue = acquire();
+		thread_queues.emplace_back(m_pool_id, std::addressof(queue));
+		return queue;
+	}
+
+	void QueuePool::flush() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		for (auto&& queue : m_queues) {
+			queue.flush();
+		}
+	}
+
+	void QueuePool::finish() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		for (auto&& queue : m_queues) {
+			queue.finish();
+		}
+	}
+
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+	std::vector<Event> QueuePool::markers() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		auto events = std::vector<Event>{};
+		for (auto&& queue : m_queues) {
+			events.push_back(queue.enqueueMarker());
+		}
+		return events;
+	}
+#endif
+
+	size_t QueuePool::size() const {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		return m_queues.size();
+	}
+
+	Context const& QueuePool::context() const {
+		return m_context;
+	}
+
+	Device const& QueuePool::device() const {
+		return m_device;
+	}
+}
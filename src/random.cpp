@@ -0,0 +1,137 @@
+#include "random.hpp"
+#include "exception.hpp"
+
+namespace cl {
+	RandomDistribution::RandomDistribution(
+		RandomDistributionType type, double first, double second, cl_ulong integer_lower, cl_ulong integer_upper
+	) :
+		m_type{type},
+		m_first{first},
+		m_second{second},
+		m_integer_lower{integer_lower},
+		m_integer_upper{integer_upper}
+	{}
+
+	RandomDistribution RandomDistribution::uniform(double lower, double upper) {
+		return {RandomDistributionType::uniform, lower, upper, 0, 0};
+	}
+
+	RandomDistribution RandomDistribution::normal(double mean, double stddev) {
+		return {RandomDistributionType::normal, mean, stddev, 0, 0};
+	}
+
+	RandomDistributionType RandomDistribution::type() const {
+		return m_type;
+	}
+
+	double RandomDistribution::first() const {
+		return m_first;
+	}
+
+	double RandomDistribution::second() const {
+		return m_second;
+	}
+
+	cl_ulong RandomDistribution::integerLower() const {
+		return m_integer_lower;
+	}
+
+	cl_ulong RandomDistribution::integerUpper() const {
+		return m_integer_upper;
+	}
+
+	namespace detail {
+		void requireDistributionType(ClTypeInfo const& type, RandomDistributionType distribution) {
+			if ((type.is_floating_point != 0) != (distribution != RandomDistributionType::integer)) {
+				throw KernelException(
+					ErrorCode::invalid_argument_value,
+					std::string{"uniform and normal distributions require floating point buffers; integer distributions integer buffers."}
+				);
+			}
+		}
+
+		std::string randomSource(ClTypeInfo const& type, size_t type_size, RandomDistributionType distribution) {
+			auto source = typePreamble(type);
+			source += (type_size == 8) ? "#define WIDE\n" : "";
+			switch (distribution) {
+				case RandomDistributionType::uniform: source += "#define UNIFORM\n"; break;
+				case RandomDistributionType::normal:  source += "#define NORMAL\n";  break;
+				case RandomDistributionType::integer: source += "#define INTEGER\n"; break;
+			}
+			return source + R"(
+inline uint4 cppcl_philox_round(uint4 c, uint2 k) {
+	const uint hi0 = mul_hi(0xD2511F53U, c.x);
+	const uint lo0 = 0xD2511F53U * c.x;
+	const uint hi1 = mul_hi(0xCD9E8D57U, c.z);
+	const uint lo1 = 0xCD9E8D57U * c.z;
+	return (uint4)(hi1 ^ c.y ^ k.x, lo1, hi0 ^ c.w ^ k.y, lo0);
+}
+
+inline uint4 cppcl_philox4x32_10(uint4 c, uint2 k) {
+	for (int round = 0; round < 9; ++round) {
+		c = cppcl_philox_round(c, k);
+		k += (uint2)(0x9E3779B9U, 0xBB67AE85U);
+	}
+	return cppcl_philox_round(c, k);
+}
+
+#if defined(WIDE)
+#define PER_BLOCK 2
+#define TWO_PI 6.283185307179586
+typedef ulong BITS;
+#define UNIT(x) ((T)((x) >> 11) * (T)(1.0 / 9007199254740992.0))
+inline void cppcl_split(uint4 r, BITS * bits) {
+	bits[0] = ((ulong)r.x << 32) | r.y;
+	bits[1] = ((ulong)r.z << 32) | r.w;
+}
+#else
+#define PER_BLOCK 4
+#define TWO_PI 6.2831853f
+typedef uint BITS;
+#define UNIT(x) ((T)((x) >> 8) * (T)(1.0f / 16777216.0f))
+inline void cppcl_split(uint4 r, BITS * bits) {
+	bits[0] = r.x;
+	bits[1] = r.y;
+	bits[2] = r.z;
+	bits[3] = r.w;
+}
+#endif
+
+__kernel void cppcl_generate_random(
+	__global T * output,
+	ulong count,
+	ulong seed,
+	ulong stream_offset,
+	ulong first_block,
+	T a,
+	T b
+) {
+	const ulong block = first_block + get_global_id(0);
+	const uint4 counter = (uint4)((uint)block, (uint)(block >> 32), 0, 0);
+	BITS bits[PER_BLOCK];
+	cppcl_split(cppcl_philox4x32_10(counter, (uint2)((uint)seed, (uint)(seed >> 32))), bits);
+	T values[PER_BLOCK];
+#if defined(UNIFORM)
+	for (int lane = 0; lane < PER_BLOCK; ++lane) values[lane] = a + (b - a) * UNIT(bits[lane]);
+#elif defined(NORMAL)
+	for (int lane = 0; lane < PER_BLOCK; lane += 2) {
+		const T radius = sqrt((T)-2 * log((T)1 - UNIT(bits[lane])));
+		const T angle = (T)TWO_PI * UNIT(bits[lane + 1]);
+		values[lane] = a + b * radius * cos(angle);
+		values[lane + 1] = a + b * radius * sin(angle);
+	}
+#else
+	for (int lane = 0; lane < PER_BLOCK; ++lane) {
+		const BITS range = (BITS)b - (BITS)a + 1;
+		values[lane] = (range == 0) ? (T)bits[lane] : (T)((BITS)a + mul_hi(bits[lane], range));
+	}
+#endif
+	for (int lane = 0; lane < PER_BLOCK; ++lane) {
+		const ulong position = block * PER_BLOCK + lane;
+		if (position >= stream_offset && position - stream_offset < count) output[position - stream_offset] = values[lane];
+	}
+}
+)";
+		}
+	}
+}
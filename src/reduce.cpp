@@ -0,0 +1,153 @@
+#include "reduce.hpp"
+#include "device.hpp"
+#include "exception.hpp"
+
+#include <string>
+#include <utility>
+
+namespace cl {
+	ReduceOperator::ReduceOperator(std::string identity, std::string combine) :
+		m_identity{std::move(identity)},
+		m_combine{std::move(combine)}
+	{}
+
+	ReduceOperator ReduceOperator::sum() {
+		return {"(T)0", "a + b"};
+	}
+
+	ReduceOperator ReduceOperator::product() {
+		return {"(T)1", "a * b"};
+	}
+
+	ReduceOperator ReduceOperator::minimum() {
+		return {"T_MAX", "min(a, b)"};
+	}
+
+	ReduceOperator ReduceOperator::maximum() {
+		return {"T_LOWEST", "max(a, b)"};
+	}
+
+	ReduceOperator ReduceOperator::bitAnd() {
+		return {"(T)(~(T)0)", "a & b"};
+	}
+
+	ReduceOperator ReduceOperator::bitOr() {
+		return {"(T)0", "a | b"};
+	}
+
+	ReduceOperator ReduceOperator::bitXor() {
+		return {"(T)0", "a ^ b"};
+	}
+
+	std::string const& ReduceOperator::identity() const {
+		return m_identity;
+	}
+
+	std::string const& ReduceOperator::combine() const {
+		return m_combine;
+	}
+
+	namespace detail {
+		std::string operatorPreamble(ReduceOperator const& op) {
+			return "#define IDENTITY (" + op.identity() + ")\n"
+				+ "inline T cppcl_combine(T a, T b) { return " + op.combine() + "; }\n";
+		}
+
+		std::string reduceSource(ClTypeInfo const& type, ReduceOperator const& op) {
+			return typePreamble(type) + operatorPreamble(op) + R"(
+__kernel void cppcl_reduce(
+	__global const T * input,
+	ulong count,
+	__global T * output,
+	__local T * scratch
+) {
+	const size_t lid = get_local_id(0);
+	const size_t stride = get_global_size(0);
+	T acc = IDENTITY;
+	for (size_t i = get_global_id(0); i < count; i += stride) {
+		acc = cppcl_combine(acc, input[i]);
+	}
+	scratch[lid] = acc;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (size_t s = get_local_size(0) / 2; s > 0; s >>= 1) {
+		if (lid < s) scratch[lid] = cppcl_combine(scratch[lid], scratch[lid + s]);
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (lid == 0) output[get_group_id(0)] = scratch[0];
+}
+)";
+		}
+
+		std::string argReduceSource(ClTypeInfo const& type, cl_bool maximum) {
+			return typePreamble(type)
+				+ "#define IDENTITY (" + ((maximum) ? "T_LOWEST" : "T_MAX") + ")\n"
+				+ "#define BETTER(a, b) ((a) " + ((maximum) ? ">" : "<") + " (b))\n"
+				+ R"(
+inline void cppcl_select(T * value, ulong * index, T other_value, ulong other_index) {
+	if (BETTER(other_value, *value) || (other_value == *value && other_index < *index)) {
+		*value = other_value;
+		*index = other_index;
+	}
+}
+
+__kernel void cppcl_arg_reduce(
+	__global const T * input,
+	__global const ulong * input_index,
+	uint has_index,
+	ulong count,
+	__global T * output,
+	__global ulong * output_index,
+	__local T * scratch,
+	__local ulong * scratch_index
+) {
+	const size_t lid = get_local_id(0);
+	const size_t stride = get_global_size(0);
+	T value = IDENTITY;
+	ulong index = ULONG_MAX;
+	for (size_t i = get_global_id(0); i < count; i += stride) {
+		cppcl_select(&value, &index, input[i], (has_index) ? input_index[i] : (ulong)i);
+	}
+	scratch[lid] = value;
+	scratch_index[lid] = index;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (size_t s = get_local_size(0) / 2; s > 0; s >>= 1) {
+		if (lid < s) {
+			T v = scratch[lid];
+			ulong x = scratch_index[lid];
+			cppcl_select(&v, &x, scratch[lid + s], scratch_index[lid + s]);
+			scratch[lid] = v;
+			scratch_index[lid] = x;
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (lid == 0) {
+		output[get_group_id(0)] = scratch[0];
+		output_index[get_group_id(0)] = scratch_index[0];
+	}
+}
+)";
+		}
+
+		size_t fittingWorkGroupSize(Device const& device, Kernel const& kernel, size_t bytes_per_item) {
+			const auto local_memory = device.localMemorySize();
+			const auto used_memory = kernel.localMemorySize(device);
+			const auto free_memory = (local_memory > used_memory) ? local_memory - used_memory : 0;
+			auto limit = std::min(device.maxWorkGroupSize(), kernel.workGroupSize(device));
+			limit = std::min(limit, static_cast<size_t>(free_memory / bytes_per_item));
+			if (limit == 0) return 0;
+			auto size = size_t{1};
+			while (size * 2 <= limit) size *= 2;
+			return size;
+		}
+
+		size_t reduceWorkGroupSize(Device const& device, Kernel const& kernel, size_t bytes_per_item) {
+			const auto size = fittingWorkGroupSize(device, kernel, bytes_per_item);
+			if (size == 0) {
+				throw DeviceException(ErrorCode::out_of_resources,
+					"the local memory of the device cannot hold the " + std::to_string(bytes_per_item)
+					+ " bytes of a single work item.");
+			}
+			return size;
+		}
+	}
+}
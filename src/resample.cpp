@@ -0,0 +1,108 @@
+#include "resample.hpp"
+#include "sampler.hpp"
+#include "program_cache.hpp"
+#include "kernel.hpp"
+
+#include <string>
+
+namespace cl {
+	namespace {
+		const auto resample_source = std::string{R"(
+__kernel void cppcl_resize(
+	__read_only image2d_t src,
+	__write_only image2d_t dst,
+	sampler_t sampler
+) {
+	const int2 pos = (int2)(get_global_id(0), get_global_id(1));
+	const float2 coord = ((float2)(pos.x, pos.y) + 0.5f) / (float2)(get_image_width(dst), get_image_height(dst));
+	write_imagef(dst, pos, read_imagef(src, sampler, coord));
+}
+
+__kernel void cppcl_warp(
+	__read_only image2d_t src,
+	__write_only image2d_t dst,
+	sampler_t sampler,
+	float4 row0,
+	float4 row1,
+	float4 row2
+) {
+	const int2 pos = (int2)(get_global_id(0), get_global_id(1));
+	const float3 p = (float3)(pos.x + 0.5f, pos.y + 0.5f, 1.0f);
+	const float w = dot(row2.xyz, p);
+	const float2 coord = (float2)(dot(row0.xyz, p), dot(row1.xyz, p)) / w;
+	write_imagef(dst, pos, read_imagef(src, sampler, coord));
+}
+
+// Binomial [1 3 3 1] / 8 per dimension: every bilinear tap merges two
+// texels with weights 1/4 and 3/4, the four taps are averaged.
+__kernel void cppcl_pyramid_down(
+	__read_only image2d_t src,
+	__write_only image2d_t dst,
+	sampler_t sampler
+) {
+	const int2 pos = (int2)(get_global_id(0), get_global_id(1));
+	const float2 base = (float2)(2.0f * pos.x, 2.0f * pos.y);
+	const float4 sum =
+		read_imagef(src, sampler, base + (float2)(0.25f, 0.25f)) +
+		read_imagef(src, sampler, base + (float2)(1.75f, 0.25f)) +
+		read_imagef(src, sampler, base + (float2)(0.25f, 1.75f)) +
+		read_imagef(src, sampler, base + (float2)(1.75f, 1.75f));
+	write_imagef(dst, pos, 0.25f * sum);
+}
+)"};
+
+		cl_float4 transformRow(std::array<float, 9> const& transform, size_t row) {
+			auto result = cl_float4{};
+			result.s[0] = transform[row * 3 + 0];
+			result.s[1] = transform[row * 3 + 1];
+			result.s[2] = transform[row * 3 + 2];
+			result.s[3] = 0.0f;
+			return result;
+		}
+	}
+
+	namespace detail {
+		Event resizeImage(
+			CommandQueue & queue,
+			MemoryObject const& src,
+			MemoryObject const& dst,
+			std::array<size_t, 2> const& dst_extent,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			auto kernel = Kernel{ProgramCache::get(context, resample_source), "cppcl_resize"};
+			kernel.setArgs(src, dst, SamplerCache::get(context, true, AddressingMode::clamp_to_edge, FilterMode::linear));
+			return queue.enqueueNDRangeKernel(kernel, dst_extent, events_in_wait_list);
+		}
+
+		Event warpImage(
+			CommandQueue & queue,
+			MemoryObject const& src,
+			MemoryObject const& dst,
+			std::array<size_t, 2> const& dst_extent,
+			std::array<float, 9> const& transform,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			auto kernel = Kernel{ProgramCache::get(context, resample_source), "cppcl_warp"};
+			kernel.setArgs(
+				src, dst, SamplerCache::get(context, false, AddressingMode::clamp, FilterMode::linear),
+				transformRow(transform, 0), transformRow(transform, 1), transformRow(transform, 2)
+			);
+			return queue.enqueueNDRangeKernel(kernel, dst_extent, events_in_wait_list);
+		}
+
+		Event pyramidDownImage(
+			CommandQueue & queue,
+			MemoryObject const& src,
+			MemoryObject const& dst,
+			std::array<size_t, 2> const& dst_extent,
+			std::vector<Event> const& events_in_wait_list
+		) {
+			const auto context = queue.context();
+			auto kernel = Kernel{ProgramCache::get(context, resample_source), "cppcl_pyramid_down"};
+			kernel.setArgs(src, dst, SamplerCache::get(context, false, AddressingMode::clamp_to_edge, FilterMode::linear));
+			return queue.enqueueNDRangeKernel(kernel, dst_extent, events_in_wait_list);
+		}
+	}
+}
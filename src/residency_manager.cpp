@@ -0,0 +1,97 @@
+#include "residency_manager.hpp"
+
+#include <algorithm>
+
+namespace cl {
+#if defined(CPPCL_CL_VERSION_1_2_ENABLED)
+	ResidencyManager::ResidencyManager() :
+		m_mutex{},
+		m_location{}
+	{}
+
+	std::vector<Event> ResidencyManager::prefetch(
+		CommandQueue & queue,
+		std::vector<MemoryObject> const& inputs,
+		std::vector<MemoryObject> const& outputs,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		const auto device_id = queue.device().id();
+		auto keep = std::vector<MemoryObject>{};
+		auto discard = std::vector<MemoryObject>{};
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			const auto elsewhere = [&](MemoryObject const& memory_object) {
+				const auto it = m_location.find(memory_object.id());
+				return it == m_location.end() || it->second != device_id;
+			};
+			const auto contains = [](std::vector<MemoryObject> const& list, MemoryObject const& memory_object) {
+				return std::any_of(list.begin(), list.end(), [&](MemoryObject const& other) {
+					return other.id() == memory_object.id();
+				});
+			};
+			for (auto&& input : inputs) {
+				if (elsewhere(input) && !contains(keep, input)) keep.push_back(input);
+			}
+			for (auto&& output : outputs) {
+				if (elsewhere(output) && !contains(keep, output) && !contains(discard, output)) {
+					discard.push_back(output);
+				}
+			}
+			for (auto&& memory_object : keep) m_location[memory_object.id()] = device_id;
+			for (auto&& memory_object : discard) m_location[memory_object.id()] = device_id;
+		}
+		auto events = std::vector<Event>{};
+		if (!keep.empty()) {
+			events.push_back(queue.enqueueMigrateMemoryObjects(keep, 0, events_in_wait_list));
+		}
+		if (!discard.empty()) {
+			events.push_back(queue.enqueueMigrateMemoryObjects(
+				discard, CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED, events_in_wait_list));
+		}
+		if (!events.empty()) queue.flush();
+		return events;
+	}
+
+	void ResidencyManager::record(
+		CommandQueue const& queue,
+		std::vector<MemoryObject> const& memory_objects
+	) {
+		const auto device_id = queue.device().id();
+		std::lock_guard<std::mutex> lock{m_mutex};
+		for (auto&& memory_object : memory_objects) {
+			m_location[memory_object.id()] = device_id;
+		}
+	}
+
+	Event ResidencyManager::launch(
+		CommandQueue & queue,
+		std::vector<MemoryObject> const& inputs,
+		std::vector<MemoryObject> const& outputs,
+		Command const& command,
+		std::vector<Event> const& events_in_wait_list
+	) {
+		auto wait = prefetch(queue, inputs, outputs, events_in_wait_list);
+		wait.insert(wait.end(), events_in_wait_list.begin(), events_in_wait_list.end());
+		auto event = command(queue, wait);
+		record(queue, inputs);
+		record(queue, outputs);
+		return event;
+	}
+
+	cl_bool ResidencyManager::isResidentOn(MemoryObject const& memory_object, Device const& device) const {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		const auto it = m_location.find(memory_object.id());
+		return it != m_location.end() && it->second == device.id();
+	}
+
+	void ResidencyManager::forget(MemoryObject const& memory_object) {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_location.erase(memory_object.id());
+	}
+
+	void ResidencyManager::clear() {
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_location.clear();
+	}
+#endif
+}
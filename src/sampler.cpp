@@ -0,0 +1,94 @@
+#include "sampler.hpp"
+#include "error_handler.hpp"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace cl {
+	const error::ErrorMap SamplerInfo::error_map = {
+		{ErrorCode::invalid_sampler, "the given sampler is invalid."}
+	};
+
+	Sampler::Sampler(cl_sampler sampler_id) :
+		Object{sampler_id}
+	{}
+
+	Sampler::Sampler(
+		Context const& context,
+		cl_bool normalized_coordinates,
+		AddressingMode addressing_mode,
+		FilterMode filter_mode
+	) :
+		Object{}
+	{
+		static const auto error_map = error::ErrorMap{
+			{ErrorCode::invalid_context, "the given context is invalid."},
+			{ErrorCode::invalid_value, "the given addressing mode, filter mode or normalized coordinates combination is invalid."},
+			{ErrorCode::invalid_operation, "there is no device in the given context which supports images."}
+		};
+		auto error = cl_int{CL_INVALID_VALUE};
+		auto new_id = clCreateSampler(
+			context.id(),
+			normalized_coordinates ? CL_TRUE : CL_FALSE,
+			static_cast<cl_addressing_mode>(addressing_mode),
+			static_cast<cl_filter_mode>(filter_mode),
+			std::addressof(error)
+		);
+		if (error::handle<SamplerException>(error, error_map)) m_id = new_id;
+	}
+
+	cl_uint Sampler::referenceCount() const {
+		return getInfo<cl_uint>(CL_SAMPLER_REFERENCE_COUNT);
+	}
+
+	Context Sampler::context() const {
+		const auto context_id = getInfo<cl_context>(CL_SAMPLER_CONTEXT);
+		ContextInfo::func_retain(context_id);
+		return {context_id};
+	}
+
+	cl_bool Sampler::normalizedCoordinates() const {
+		return getInfo<cl_bool>(CL_SAMPLER_NORMALIZED_COORDS);
+	}
+
+	AddressingMode Sampler::addressingMode() const {
+		return static_cast<AddressingMode>(getInfo<cl_addressing_mode>(CL_SAMPLER_ADDRESSING_MODE));
+	}
+
+	FilterMode Sampler::filterMode() const {
+		return static_cast<FilterMode>(getInfo<cl_filter_mode>(CL_SAMPLER_FILTER_MODE));
+	}
+
+	namespace {
+		using CacheKey = std::tuple<cl_context, cl_bool, cl_addressing_mode, cl_filter_mode>;
+
+		std::mutex cache_mutex;
+		std::map<CacheKey, Sampler> cache;
+	}
+
+	Sampler SamplerCache::get(
+		Context const& context,
+		cl_bool normalized_coordinates,
+		AddressingMode addressing_mode,
+		FilterMode filter_mode
+	) {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		auto key = CacheKey{
+			context.id(),
+			normalized_coordinates ? CL_TRUE : CL_FALSE,
+			static_cast<cl_addressing_mode>(addressing_mode),
+			static_cast<cl_filter_mode>(filter_mode)
+		};
+		const auto found = cache.find(key);
+		if (found != cache.end()) return found->second;
+		auto sampler = Sampler{context, normalized_coordinates, addressing_mode, filter_mode};
+		cache.emplace(std::move(key), sampler);
+		return sampler;
+	}
+
+	void SamplerCache::clear() {
+		std::lock_guard<std::mutex> lock{cache_mutex};
+		cache.clear();
+	}
+}
@@ -0,0 +1,211 @@
+#include "scan.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string scanSource(ClTypeInfo const& type, ReduceOperator const& op) {
+			return typePreamble(type) + operatorPreamble(op) + R"(
+__kernel void cppcl_scan_blocks(
+	__global const T * input,
+	__global T * output,
+	__global T * block_sums,
+	ulong count,
+	uint inclusive,
+	__local T * scratch
+) {
+	const size_t lid = get_local_id(0);
+	const size_t n = 2 * get_local_size(0);
+	const size_t base = get_group_id(0) * n;
+	const size_t ai = lid;
+	const size_t bi = lid + get_local_size(0);
+	const T a = (base + ai < count) ? input[base + ai] : IDENTITY;
+	const T b = (base + bi < count) ? input[base + bi] : IDENTITY;
+	scratch[ai] = a;
+	scratch[bi] = b;
+	size_t offset = 1;
+	for (size_t d = n >> 1; d > 0; d >>= 1) {
+		barrier(CLK_LOCAL_MEM_FENCE);
+		if (lid < d) {
+			const size_t x = offset * (2 * lid + 1) - 1;
+			const size_t y = offset * (2 * lid + 2) - 1;
+			scratch[y] = cppcl_combine(scratch[x], scratch[y]);
+		}
+		offset <<= 1;
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	if (lid == 0) {
+		block_sums[get_group_id(0)] = scratch[n - 1];
+		scratch[n - 1] = IDENTITY;
+	}
+	for (size_t d = 1; d < n; d <<= 1) {
+		offset >>= 1;
+		barrier(CLK_LOCAL_MEM_FENCE);
+		if (lid < d) {
+			const size_t x = offset * (2 * lid + 1) - 1;
+			const size_t y = offset * (2 * lid + 2) - 1;
+			const T t = scratch[x];
+			scratch[x] = scratch[y];
+			scratch[y] = cppcl_combine(scratch[y], t);
+		}
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	if (base + ai < count) output[base + ai] = (inclusive) ? cppcl_combine(scratch[ai], a) : scratch[ai];
+	if (base + bi < count) output[base + bi] = (inclusive) ? cppcl_combine(scratch[bi], b) : scratch[bi];
+}
+
+__kernel void cppcl_scan_add(
+	__global T * output,
+	__global const T * block_offsets,
+	ulong count,
+	ulong block_size
+) {
+	const size_t i = get_global_id(0);
+	if (i < count) output[i] = cppcl_combine(block_offsets[i / block_size], output[i]);
+}
+)";
+		}
+
+		std::string compactSource(ClTypeInfo const& type, std::string const& predicate) {
+			return typePreamble(type)
+				+ "inline int cppcl_predicate(T x) { return (" + predicate + "); }\n"
+				+ R"(
+__kernel void cppcl_flag(
+	__global const T * input,
+	__global uint * flags,
+	ulong count
+) {
+	const size_t i = get_global_id(0);
+	if (i < count) flags[i] = (cppcl_predicate(input[i])) ? 1 : 0;
+}
+
+__kernel void cppcl_scatter(
+	__global const T * input,
+	__global const uint * flags,
+	__global const uint * positions,
+	ulong count,
+	__global T * output,
+	__global uint * selected_count,
+	uint partition
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	const uint total = positions[count - 1] + flags[count - 1];
+	if (i == 0) *selected_count = total;
+	if (flags[i]) {
+		output[positions[i]] = input[i];
+	} else if (partition) {
+		output[total + (i - positions[i])] = input[i];
+	}
+}
+)";
+		}
+
+		std::string segmentedScanSource(ClTypeInfo const& type, ReduceOperator const& op) {
+			return typePreamble(type) + operatorPreamble(op) + R"(
+__kernel void cppcl_segmented_scan_blocks(
+	__global const T * input,
+	__global const uint * heads,
+	__global T * output,
+	__global T * block_values,
+	__global uint * block_heads,
+	__global uint * block_first_head,
+	ulong count,
+	__local T * values,
+	__local uint * flags
+) {
+	const uint lid = get_local_id(0);
+	const uint n = get_local_size(0);
+	const size_t i = get_global_id(0);
+	T value = (i < count) ? input[i] : IDENTITY;
+	uint flag = (i < count) ? heads[i] : 0;
+	values[lid] = value;
+	flags[lid] = flag;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (uint offset = 1; offset < n; offset <<= 1) {
+		T previous_value = IDENTITY;
+		uint previous_flag = 0;
+		if (lid >= offset) {
+			previous_value = values[lid - offset];
+			previous_flag = flags[lid - offset];
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+		if (lid >= offset) {
+			if (!flag) value = cppcl_combine(previous_value, value);
+			flag |= previous_flag;
+			values[lid] = value;
+			flags[lid] = flag;
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (i < count) output[i] = value;
+	if (lid == n - 1) {
+		block_values[get_group_id(0)] = value;
+		block_heads[get_group_id(0)] = flag;
+		if (!flag) block_first_head[get_group_id(0)] = n;
+	}
+	if (flag && (lid == 0 || !flags[lid - 1])) block_first_head[get_group_id(0)] = lid;
+}
+
+__kernel void cppcl_segmented_scan_add(
+	__global T * output,
+	__global const T * block_prefix,
+	__global const uint * block_first_head,
+	ulong count,
+	ulong block_size
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	const size_t block = i / block_size;
+	if (block > 0 && (i % block_size) < block_first_head[block]) {
+		output[i] = cppcl_combine(block_prefix[block - 1], output[i]);
+	}
+}
+
+__kernel void cppcl_segmented_scan_serial(
+	__global const T * input,
+	__global const uint * heads,
+	__global T * output,
+	ulong count
+) {
+	T value = IDENTITY;
+	for (ulong i = 0; i < count; ++i) {
+		value = (heads[i]) ? input[i] : cppcl_combine(value, input[i]);
+		output[i] = value;
+	}
+}
+)";
+		}
+
+		std::string reduceByKeySource(ClTypeInfo const& key, ClTypeInfo const& value) {
+			return typePreamble(value) + typePreamble(key, "K") + R"(
+__kernel void cppcl_segment_heads(
+	__global const K * keys,
+	__global uint * heads,
+	ulong count
+) {
+	const size_t i = get_global_id(0);
+	if (i < count) heads[i] = (i == 0 || keys[i] != keys[i - 1]) ? 1 : 0;
+}
+
+__kernel void cppcl_reduce_by_key_scatter(
+	__global const K * keys,
+	__global const uint * heads,
+	__global const uint * positions,
+	__global const T * reduced,
+	ulong count,
+	__global K * keys_output,
+	__global T * values_output,
+	__global uint * segment_count
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	if (i == 0) *segment_count = positions[count - 1] + heads[count - 1];
+	if (i == count - 1 || heads[i + 1]) {
+		const uint segment = positions[i] + heads[i] - 1;
+		keys_output[segment] = keys[i];
+		values_output[segment] = reduced[i];
+	}
+}
+)";
+		}
+	}
+}
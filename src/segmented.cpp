@@ -0,0 +1,65 @@
+#include "segmented.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string segmentSource() {
+			return R"(
+__kernel void cppcl_segment_ids(
+	__global const uint * offsets,
+	uint segments,
+	ulong count,
+	__global uint * ids,
+	__global uint * heads
+) {
+	const size_t i = get_global_id(0);
+	if (i >= count) return;
+	uint low = 0;
+	uint high = segments;
+	while (high - low > 1) {
+		const uint middle = low + (high - low) / 2;
+		if (offsets[middle] <= i) low = middle;
+		else high = middle;
+	}
+	ids[i] = low;
+	heads[i] = (offsets[low] == i) ? 1 : 0;
+}
+)";
+		}
+
+		std::string segmentedSource(ClTypeInfo const& type, ReduceOperator const& op) {
+			return typePreamble(type) + operatorPreamble(op) + R"(
+__kernel void cppcl_segmented_reduce(
+	__global const T * input,
+	__global const uint * offsets,
+	__global T * output,
+	__local T * scratch
+) {
+	const size_t lid = get_local_id(0);
+	const size_t segment = get_group_id(0);
+	const uint end = offsets[segment + 1];
+	T acc = IDENTITY;
+	for (uint i = offsets[segment] + lid; i < end; i += get_local_size(0)) {
+		acc = cppcl_combine(acc, input[i]);
+	}
+	scratch[lid] = acc;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (size_t s = get_local_size(0) / 2; s > 0; s >>= 1) {
+		if (lid < s) scratch[lid] = cppcl_combine(scratch[lid], scratch[lid + s]);
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (lid == 0) output[segment] = scratch[0];
+}
+
+__kernel void cppcl_segmented_shift(
+	__global const T * inclusive,
+	__global const uint * heads,
+	__global T * output,
+	ulong count
+) {
+	const size_t i = get_global_id(0);
+	if (i < count) output[i] = (heads[i]) ? IDENTITY : inclusive[i - 1];
+}
+)";
+		}
+	}
+}
@@ -0,0 +1,167 @@
+#include "sort.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string sortSource(ClTypeInfo const& key, std::string const& bits_type, ClTypeInfo const* value) {
+			auto source = typePreamble(key) + "typedef " + bits_type + " K;\n";
+			if (value) {
+				source += typePreamble(*value, "V") + "#define CPPCL_WITH_VALUES\n";
+			}
+			if (key.is_floating_point) {
+				source += "#define CPPCL_KEY_FLOAT\n";
+			} else if (key.is_signed) {
+				source += "#define CPPCL_KEY_SIGNED\n";
+			}
+			return source + R"(
+#define RADIX_BITS 4
+#define RADIX (1 << RADIX_BITS)
+#define SIGN_BIT ((K)1 << (8 * sizeof(K) - 1))
+
+inline K cppcl_key_bits(T key) {
+	const K bits = *(const K *)&key;
+#if defined(CPPCL_KEY_FLOAT)
+	return bits ^ ((bits & SIGN_BIT) ? (K)(~(K)0) : SIGN_BIT);
+#elif defined(CPPCL_KEY_SIGNED)
+	return bits ^ SIGN_BIT;
+#else
+	return bits;
+#endif
+}
+
+inline uint cppcl_local_exclusive_scan(__local uint * scratch, uint value, uint * total) {
+	const uint lid = get_local_id(0);
+	const uint n = get_local_size(0);
+	scratch[lid] = value;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (uint offset = 1; offset < n; offset <<= 1) {
+		const uint add = (lid >= offset) ? scratch[lid - offset] : 0;
+		barrier(CLK_LOCAL_MEM_FENCE);
+		scratch[lid] += add;
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	*total = scratch[n - 1];
+	const uint inclusive = scratch[lid];
+	barrier(CLK_LOCAL_MEM_FENCE);
+	return inclusive - value;
+}
+
+__kernel void cppcl_radix_count(
+	__global const T * keys,
+	ulong count,
+	uint shift,
+	__global uint * histograms
+) {
+	__local uint histogram[RADIX];
+	const size_t lid = get_local_id(0);
+	const size_t i = get_global_id(0);
+	if (lid < RADIX) histogram[lid] = 0;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	if (i < count) atomic_inc(&histogram[(cppcl_key_bits(keys[i]) >> shift) & (RADIX - 1)]);
+	barrier(CLK_LOCAL_MEM_FENCE);
+	if (lid < RADIX) histograms[lid * get_num_groups(0) + get_group_id(0)] = histogram[lid];
+}
+
+__kernel void cppcl_radix_scatter(
+	__global const T * keys_in,
+	__global T * keys_out,
+	ulong count,
+	uint shift,
+	__global const uint * offsets,
+	__local K * local_bits,
+	__local uint * local_index,
+	__local uint * scratch
+#if defined(CPPCL_WITH_VALUES)
+	, __global const V * values_in
+	, __global V * values_out
+#endif
+) {
+	__local uint digit_start[RADIX];
+	const uint lid = get_local_id(0);
+	const uint n = get_local_size(0);
+	const size_t i = get_global_id(0);
+	K bits = (i < count) ? cppcl_key_bits(keys_in[i]) : (K)(~(K)0);
+	uint index = (uint)i;
+	for (uint b = 0; b < RADIX_BITS; ++b) {
+		const uint bit = (uint)((bits >> (shift + b)) & 1);
+		uint total_ones;
+		const uint ones_before = cppcl_local_exclusive_scan(scratch, bit, &total_ones);
+		const uint position = (bit) ? (n - total_ones) + ones_before : lid - ones_before;
+		local_bits[position] = bits;
+		local_index[position] = index;
+		barrier(CLK_LOCAL_MEM_FENCE);
+		bits = local_bits[lid];
+		index = local_index[lid];
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	const uint digit = (uint)((bits >> shift) & (RADIX - 1));
+	if (lid == 0 || digit != (uint)((local_bits[lid - 1] >> shift) & (RADIX - 1))) {
+		digit_start[digit] = lid;
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	if (index < count) {
+		const uint target = offsets[digit * get_num_groups(0) + get_group_id(0)] + (lid - digit_start[digit]);
+		keys_out[target] = keys_in[index];
+#if defined(CPPCL_WITH_VALUES)
+		values_out[target] = values_in[index];
+#endif
+	}
+}
+
+__kernel void cppcl_bitonic_sort(
+	__global T * keys,
+	ulong count,
+	uint size,
+	__local K * local_bits,
+	__local uint * local_index,
+	__local T * local_keys
+#if defined(CPPCL_WITH_VALUES)
+	, __global V * values
+	, __local V * local_values
+#endif
+) {
+	const uint lid = get_local_id(0);
+	const uint n = get_local_size(0);
+	for (uint i = lid; i < size; i += n) {
+		if (i < count) {
+			local_keys[i] = keys[i];
+			local_bits[i] = cppcl_key_bits(local_keys[i]);
+#if defined(CPPCL_WITH_VALUES)
+			local_values[i] = values[i];
+#endif
+		} else {
+			local_bits[i] = (K)(~(K)0);
+		}
+		local_index[i] = i;
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	for (uint k = 2; k <= size; k <<= 1) {
+		for (uint j = k >> 1; j > 0; j >>= 1) {
+			for (uint i = lid; i < size; i += n) {
+				const uint partner = i ^ j;
+				if (partner > i) {
+					const K a = local_bits[i];
+					const K b = local_bits[partner];
+					const int greater = (a > b) || (a == b && local_index[i] > local_index[partner]);
+					if (greater == ((i & k) == 0)) {
+						local_bits[i] = b;
+						local_bits[partner] = a;
+						const uint t = local_index[i];
+						local_index[i] = local_index[partner];
+						local_index[partner] = t;
+					}
+				}
+			}
+			barrier(CLK_LOCAL_MEM_FENCE);
+		}
+	}
+	for (uint i = lid; i < count; i += n) {
+		keys[i] = local_keys[local_index[i]];
+#if defined(CPPCL_WITH_VALUES)
+		values[i] = local_values[local_index[i]];
+#endif
+	}
+}
+)";
+		}
+	}
+}
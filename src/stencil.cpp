@@ -0,0 +1,118 @@
+#include "stencil.hpp"
+#include "exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace cl {
+	namespace detail {
+		std::string stencilSource(ClTypeInfo const& type) {
+			return typePreamble(type) + R"(
+#define TILE_X (LX + 2 * RX)
+#define TILE_Y (LY + 2 * RY)
+#define TILE_Z (LZ + 2 * RZ)
+
+__constant T cppcl_coefficients[] = { CPPCL_COEFFICIENTS };
+
+__kernel __attribute__((reqd_work_group_size(LX, LY, LZ)))
+void cppcl_stencil(
+	__global const T * input,
+	__global T * output,
+	uint width,
+	uint height,
+	uint depth
+) {
+	__local T tile[TILE_Z][TILE_Y][TILE_X];
+	const int lx = get_local_id(0);
+	const int ly = get_local_id(1);
+	const int lz = get_local_id(2);
+	const int base_x = get_group_id(0) * LX - RX;
+	const int base_y = get_group_id(1) * LY - RY;
+	const int base_z = get_group_id(2) * LZ - RZ;
+	for (int z = lz; z < TILE_Z; z += LZ) {
+		const int sz = clamp(base_z + z, 0, (int)depth - 1);
+		for (int y = ly; y < TILE_Y; y += LY) {
+			const int sy = clamp(base_y + y, 0, (int)height - 1);
+			for (int x = lx; x < TILE_X; x += LX) {
+				const int sx = clamp(base_x + x, 0, (int)width - 1);
+				tile[z][y][x] = input[((size_t)sz * height + sy) * width + sx];
+			}
+		}
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	const size_t gx = get_global_id(0);
+	const size_t gy = get_global_id(1);
+	const size_t gz = get_global_id(2);
+	if (gx >= width || gy >= height || gz >= depth) return;
+	T sum = (T)0;
+	for (int dz = 0; dz <= 2 * RZ; ++dz) {
+		for (int dy = 0; dy <= 2 * RY; ++dy) {
+			for (int dx = 0; dx <= 2 * RX; ++dx) {
+				sum += cppcl_coefficients[(dz * (2 * RY + 1) + dy) * (2 * RX + 1) + dx] * tile[lz + dz][ly + dy][lx + dx];
+			}
+		}
+	}
+	output[(gz * height + gy) * width + gx] = sum;
+}
+)";
+		}
+
+		std::string stencilOptions(
+			ClTypeInfo const& type,
+			std::array<size_t, 3> const& radius,
+			std::array<size_t, 3> const& local_size,
+			std::vector<double> const& coefficients
+		) {
+			const auto suffix = (type.scalar == ScalarType::float_type) ? "f" : "";
+			auto options = std::ostringstream{};
+			options << "-D RX=" << radius[0] << " -D RY=" << radius[1] << " -D RZ=" << radius[2]
+				<< " -D LX=" << local_size[0] << " -D LY=" << local_size[1] << " -D LZ=" << local_size[2]
+				<< " -D CPPCL_COEFFICIENTS=";
+			for (auto i = size_t{0}; i < coefficients.size(); ++i) {
+				if (!std::isfinite(coefficients[i])) {
+					throw KernelException(ErrorCode::invalid_argument_value,
+						"stencil coefficient " + std::to_string(i) + " is not finite.");
+				}
+				if (i > 0) options << ',';
+				auto literal = std::ostringstream{};
+				literal << std::setprecision(17) << coefficients[i];
+				auto text = literal.str();
+				if (type.is_floating_point) {
+					if (text.find_first_of(".en") == std::string::npos) text += ".0";
+					text += suffix;
+				}
+				options << "(T)(" << text << ')';
+			}
+			return options.str();
+		}
+
+		std::array<size_t, 3> stencilLocalSize(
+			Device const& device,
+			size_t dimensions,
+			std::array<size_t, 3> const& radius,
+			size_t element_size,
+			size_t max_work_group_size
+		) {
+			auto local_size = (dimensions == 2)
+				? std::array<size_t, 3>{{16, 16, 1}}
+				: std::array<size_t, 3>{{8, 8, 4}};
+			const auto max_sizes = device.maxWorkItemSizes();
+			const auto local_memory = device.localMemorySize();
+			const auto tile_bytes = [&]() {
+				auto bytes = element_size;
+				for (auto i = size_t{0}; i < 3; ++i) bytes *= local_size[i] + 2 * radius[i];
+				return bytes;
+			};
+			while (true) {
+				const auto work_group_size = local_size[0] * local_size[1] * local_size[2];
+				auto too_large = work_group_size > max_work_group_size || tile_bytes() > local_memory / 2;
+				for (auto i = size_t{0}; i < 3 && i < max_sizes.size(); ++i) too_large |= local_size[i] > max_sizes[i];
+				if (!too_large || work_group_size == 1) return local_size;
+				const auto largest = std::max_element(local_size.begin(), local_size.end());
+				*largest /= 2;
+			}
+		}
+	}
+}
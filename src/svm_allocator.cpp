@@ -0,0 +1,28 @@
+#include "svm_allocator.hpp"
+#include "device.hpp"
+
+#include <algorithm>
+
+namespace cl {
+#if defined(CPPCL_CL_VERSION_2_0_ENABLED)
+	namespace detail {
+		void * svmAlloc(Context const& context, cl_svm_mem_flags flags, size_t size, size_t alignment) {
+			if (size == 0) return nullptr;
+			auto pointer = clSVMAlloc(context.id(), flags, size, static_cast<cl_uint>(alignment));
+			if (pointer == nullptr) throw std::bad_alloc{};
+			return pointer;
+		}
+
+		void svmFree(Context const& context, void * pointer) {
+			if (pointer != nullptr) clSVMFree(context.id(), pointer);
+		}
+
+		cl_bool supportsFineGrainSvm(Context const& context) {
+			const auto devices = context.devices();
+			return std::all_of(devices.begin(), devices.end(), [](Device const& device) {
+				return (device.svmCapabilities() & CL_DEVICE_SVM_FINE_GRAIN_BUFFER) != 0;
+			});
+		}
+	}
+#endif
+}
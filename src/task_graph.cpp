@@ -0,0 +1,94 @@
+#include "task_graph.hpp"
+
+#include <cassert>
+#include <memory>
+
+namespace cl {
+	namespace {
+		void submitHostTask(ThreadPool & pool, TaskGraph::HostTask task, Event done, cl_bool failed) {
+			pool.submit([task, done, failed]() mutable {
+				if (failed) {
+					done.fail();
+					return;
+				}
+				try {
+					task();
+				}
+				catch (...) {
+					done.fail();
+					return;
+				}
+				done.finish();
+			});
+		}
+	}
+
+	TaskGraph::TaskGraph(Context const& context, ThreadPool & pool) :
+		m_context{context},
+		m_pool(pool),
+		m_nodes{}
+	{}
+
+	TaskGraph::NodeId TaskGraph::addNode(Node node) {
+		for (auto&& dependency : node.dependencies) {
+			assert(dependency < m_nodes.size());
+			(void) dependency;
+		}
+		m_nodes.push_back(std::move(node));
+		return m_nodes.size() - 1;
+	}
+
+	TaskGraph::NodeId TaskGraph::addDevice(
+		CommandQueue const& queue,
+		DeviceCommand command,
+		std::vector<NodeId> const& dependencies
+	) {
+		return addNode(Node{{queue}, std::move(command), HostTask{}, dependencies});
+	}
+
+	TaskGraph::NodeId TaskGraph::addHost(
+		HostTask task,
+		std::vector<NodeId> const& dependencies
+	) {
+		return addNode(Node{{}, DeviceCommand{}, std::move(task), dependencies});
+	}
+
+	void TaskGraph::addDependency(NodeId node, NodeId dependency) {
+		assert(node < m_nodes.size());
+		assert(dependency < node);
+		m_nodes[node].dependencies.push_back(dependency);
+	}
+
+	size_t TaskGraph::size() const {
+		return m_nodes.size();
+	}
+
+	std::vector<Event> TaskGraph::run() {
+		auto events = std::vector<Event>{};
+		auto queues = std::vector<CommandQueue>{};
+		for (auto&& node : m_nodes) {
+			auto wait = std::vector<Event>{};
+			for (auto&& dependency : node.dependencies) {
+				wait.push_back(events[dependency]);
+			}
+			if (!node.queue.empty()) {
+				auto & queue = node.queue.front();
+				events.push_back(node.command(queue, wait));
+				queues.push_back(queue);
+				continue;
+			}
+			auto done = Event{m_context};
+			events.push_back(done);
+			auto pool = std::addressof(m_pool);
+			auto task = node.task;
+			detail::whenComplete(wait, [pool, task, done](cl_bool failed) {
+				submitHostTask(*pool, task, done, failed);
+			});
+		}
+		// Host tasks waiting on device commands only start once those reach the device.
+		for (auto&& queue : queues) {
+			queue.flush();
+		}
+		return events;
+	}
+}
@@ -0,0 +1,105 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace cl {
+	namespace {
+		thread_local ThreadPool const* current_pool = nullptr;
+		thread_local size_t current_index = 0;
+	}
+
+	ThreadPool::ThreadPool(size_t count_threads) :
+		m_queues{},
+		m_workers{},
+		m_mutex{},
+		m_wakeup{},
+		m_pending{0},
+		m_stopping{false},
+		m_next_queue{0}
+	{
+		const auto count = std::max(count_threads, size_t{1});
+		for (auto i = size_t{0}; i < count; ++i) {
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+		}
+		for (auto i = size_t{0}; i < count; ++i) {
+			m_workers.emplace_back([this, i] { work(i); });
+		}
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_stopping = true;
+		}
+		m_wakeup.notify_all();
+		for (auto&& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	bool ThreadPool::take(size_t index, std::function<void()> & task) {
+		{
+			auto & own = *m_queues[index];
+			std::lock_guard<std::mutex> lock{own.mutex};
+			if (!own.tasks.empty()) {
+				task = std::move(own.tasks.back());
+				own.tasks.pop_back();
+				return true;
+			}
+		}
+		for (auto offset = size_t{1}; offset < m_queues.size(); ++offset) {
+			auto & victim = *m_queues[(index + offset) % m_queues.size()];
+			std::lock_guard<std::mutex> lock{victim.mutex};
+			if (!victim.tasks.empty()) {
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void ThreadPool::work(size_t index) {
+		current_pool = this;
+		current_index = index;
+		for (;;) {
+			auto task = std::function<void()>{};
+			if (take(index, task)) {
+				{
+					std::lock_guard<std::mutex> lock{m_mutex};
+					--m_pending;
+				}
+				task();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock{m_mutex};
+			if (m_stopping && m_pending == 0) return;
+			m_wakeup.wait(lock, [this] { return m_stopping || m_pending > 0; });
+		}
+	}
+
+	void ThreadPool::submit(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			++m_pending;
+		}
+		const auto index = (current_pool == this)
+			? current_index
+			: m_next_queue.fetch_add(1) % m_queues.size();
+		{
+			auto & queue = *m_queues[index];
+			std::lock_guard<std::mutex> lock{queue.mutex};
+			queue.tasks.push_back(std::move(task));
+		}
+		m_wakeup.notify_one();
+	}
+
+	size_t ThreadPool::size() const {
+		return m_workers.size();
+	}
+
+	ThreadPool & ThreadPool::shared() {
+		static ThreadPool pool;
+		return pool;
+	}
+}
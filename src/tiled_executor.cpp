@@ -0,0 +1,65 @@
+#include "tiled_executor.hpp"
+#include "device.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace cl {
+	namespace detail {
+		std::vector<Tile> tileGrid(
+			std::array<size_t, 2> const& image_extent,
+			std::array<size_t, 2> const& tile_extent,
+			size_t halo
+		) {
+			auto tiles = std::vector<Tile>{};
+			for (auto y = size_t{0}; y < image_extent[1]; y += tile_extent[1]) {
+				for (auto x = size_t{0}; x < image_extent[0]; x += tile_extent[0]) {
+					auto tile = Tile{};
+					tile.origin = {{x, y}};
+					tile.extent = {{
+						std::min(tile_extent[0], image_extent[0] - x),
+						std::min(tile_extent[1], image_extent[1] - y)
+					}};
+					for (auto d = size_t{0}; d < 2; ++d) {
+						tile.halo_origin[d] = (tile.origin[d] > halo) ? tile.origin[d] - halo : 0;
+						const auto halo_end = std::min(tile.origin[d] + tile.extent[d] + halo, image_extent[d]);
+						tile.halo_extent[d] = halo_end - tile.halo_origin[d];
+						tile.core_offset[d] = tile.origin[d] - tile.halo_origin[d];
+					}
+					tiles.push_back(tile);
+				}
+			}
+			return tiles;
+		}
+
+		std::array<size_t, 2> maxTileExtent(
+			std::vector<CommandQueue> const& queues,
+			size_t halo,
+			size_t bytes_per_pixel
+		) {
+			auto max_width = std::numeric_limits<size_t>::max();
+			auto max_height = std::numeric_limits<size_t>::max();
+			auto max_bytes = std::numeric_limits<cl_ulong>::max();
+			for (auto&& queue : queues) {
+				const auto device = queue.device();
+				max_width = std::min(max_width, device.maxWidthImage2D());
+				max_height = std::min(max_height, device.maxHeightImage2D());
+				max_bytes = std::min(max_bytes, device.maxMemoryAllocationSize());
+			}
+			if (max_width <= 2 * halo || max_height <= 2 * halo) {
+				throw DeviceException(ErrorCode::invalid_image_size,
+					std::string{"the halo does not fit into the maximum image extent of the devices."});
+			}
+			auto extent = std::array<size_t, 2>{{max_width - 2 * halo, max_height - 2 * halo}};
+			const auto bytes = [&] {
+				return static_cast<cl_ulong>((extent[0] + 2 * halo) * (extent[1] + 2 * halo) * bytes_per_pixel);
+			};
+			while (bytes() > max_bytes && (extent[0] > 1 || extent[1] > 1)) {
+				auto & larger = (extent[0] >= extent[1]) ? extent[0] : extent[1];
+				larger = (larger + 1) / 2;
+			}
+			return extent;
+		}
+	}
+}
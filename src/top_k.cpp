@@ -0,0 +1,83 @@
+#include "top_k.hpp"
+
+namespace cl {
+	namespace detail {
+		std::string topKSource(ClTypeInfo const& type, size_t k) {
+			return typePreamble(type)
+				+ "#define K " + std::to_string(k) + "\n"
+				+ "#define KP " + std::to_string(topKPadded(k)) + "\n"
+				+ R"(
+inline int cppcl_better(T a, ulong a_index, T b, ulong b_index) {
+	return a > b || (a == b && a_index < b_index);
+}
+
+__kernel void cppcl_top_k(
+	__global const T * input,
+	__global const ulong * input_index,
+	uint has_index,
+	ulong count,
+	__global T * output,
+	__global ulong * output_index,
+	__local T * values,
+	__local ulong * indices
+) {
+	const uint lid = get_local_id(0);
+	const uint n = get_local_size(0);
+	T best[K];
+	ulong best_index[K];
+	for (uint j = 0; j < K; ++j) {
+		best[j] = T_LOWEST;
+		best_index[j] = ULONG_MAX;
+	}
+	for (size_t i = get_global_id(0); i < count; i += get_global_size(0)) {
+		const T value = input[i];
+		const ulong index = (has_index) ? input_index[i] : i;
+		if (!cppcl_better(value, index, best[K - 1], best_index[K - 1])) continue;
+		uint j = K - 1;
+		while (j > 0 && cppcl_better(value, index, best[j - 1], best_index[j - 1])) {
+			best[j] = best[j - 1];
+			best_index[j] = best_index[j - 1];
+			--j;
+		}
+		best[j] = value;
+		best_index[j] = index;
+	}
+	for (uint j = 0; j < KP; ++j) {
+		values[lid * KP + j] = (j < K) ? best[j] : T_LOWEST;
+		indices[lid * KP + j] = (j < K) ? best_index[j] : ULONG_MAX;
+	}
+	barrier(CLK_LOCAL_MEM_FENCE);
+	const uint size = n * KP;
+	for (uint k = 2; k <= size; k <<= 1) {
+		for (uint j = k >> 1; j > 0; j >>= 1) {
+			for (uint i = lid; i < size; i += n) {
+				const uint partner = i ^ j;
+				if (partner <= i) continue;
+				const int partner_better = cppcl_better(values[partner], indices[partner], values[i], indices[i]);
+				if (partner_better == ((i & k) == 0)) {
+					const T value = values[i];
+					const ulong index = indices[i];
+					values[i] = values[partner];
+					indices[i] = indices[partner];
+					values[partner] = value;
+					indices[partner] = index;
+				}
+			}
+			barrier(CLK_LOCAL_MEM_FENCE);
+		}
+	}
+	for (uint j = lid; j < K; j += n) {
+		output[get_group_id(0) * K + j] = values[j];
+		output_index[get_group_id(0) * K + j] = indices[j];
+	}
+}
+)";
+		}
+
+		size_t topKPadded(size_t k) {
+			auto padded = size_t{1};
+			while (padded < k) padded *= 2;
+			return padded;
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <string>
+
+#include "cppcl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+	template <typename Function>
+	double measure_ms(Function function, int repetitions = 5) {
+		auto best = std::numeric_limits<double>::max();
+		for (auto i = 0; i < repetitions; ++i) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			function();
+			const auto end = std::chrono::high_resolution_clock::now();
+			best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+		}
+		return best;
+	}
+
+	void benchmark_reduce(cl::Context const& context, cl::CommandQueue & queue) {
+		std::cout << "reduce (sum, float): device reduce vs. readback + host std::accumulate\n";
+		auto generator = std::mt19937{42};
+		auto distribution = std::uniform_real_distribution<float>{0.0f, 1.0f};
+		for (auto count = size_t{1} << 16; count <= (size_t{1} << 26); count <<= 2) {
+			auto host = std::vector<float>(count);
+			std::generate(host.begin(), host.end(), [&]() { return distribution(generator); });
+			auto buffer = cl::Buffer<float>{context, cl::MemoryFlags{}.readWrite(true), count};
+			queue.enqueueWrite(buffer, host.begin(), host.end());
+
+			auto device_result = 0.0f;
+			const auto device_ms = measure_ms([&]() {
+				auto result = cl::reduce(queue, buffer, cl::ReduceOperator::sum());
+				queue.enqueueRead(result.result, &device_result, &device_result + 1, 0, {result.event});
+			});
+
+			auto host_result = 0.0f;
+			auto readback = std::vector<float>(count);
+			const auto host_ms = measure_ms([&]() {
+				queue.enqueueRead(buffer, readback.begin(), readback.end());
+				host_result = std::accumulate(readback.begin(), readback.end(), 0.0f);
+			});
+
+			std::cout << "\t" << count << " elements: device " << device_ms << " ms (" << device_result << ")"
+					  << ", host " << host_ms << " ms (" << host_result << ")\n";
+		}
+	}
+
+	void benchmark_sort(cl::Context const& context, cl::CommandQueue & queue) {
+		std::cout << "sort (uint keys): device radix sort vs. readback + host std::sort\n";
+		auto generator = std::mt19937{42};
+		for (auto count = size_t{1} << 10; count <= (size_t{1} << 24); count <<= 2) {
+			auto host = std::vector<cl_uint>(count);
+			std::generate(host.begin(), host.end(), [&]() { return static_cast<cl_uint>(generator()); });
+			auto buffer = cl::Buffer<cl_uint>{context, cl::MemoryFlags{}.readWrite(true), count};
+
+			const auto device_ms = measure_ms([&]() {
+				queue.enqueueWrite(buffer, host.begin(), host.end());
+				cl::sort(queue, buffer);
+				queue.finish();
+			});
+
+			auto readback = std::vector<cl_uint>(count);
+			const auto host_ms = measure_ms([&]() {
+				queue.enqueueWrite(buffer, host.begin(), host.end());
+				queue.enqueueRead(buffer, readback.begin(), readback.end());
+				std::sort(readback.begin(), readback.end());
+				queue.enqueueWrite(buffer, readback.begin(), readback.end());
+			});
+
+			auto sorted = std::vector<cl_uint>(count);
+			queue.enqueueRead(buffer, sorted.begin(), sorted.end());
+			std::cout << "\t" << count << " elements: device " << device_ms << " ms"
+					  << ", host " << host_ms << " ms"
+					  << ((std::is_sorted(sorted.begin(), sorted.end())) ? "" : " (NOT SORTED)") << "\n";
+		}
+	}
+}
+
+int main(int, const char**) {
+	auto platforms = cl::Platform::getPlatforms();
+	auto platform = platforms[0];
+	auto devices = platform.getDevices(cl::DeviceType::all);
+	auto device = devices[0];
+	std::cout << "Benchmarking on " << device.name() << " (" << platform.name() << ")\n";
+
+	auto usr_data = int{0};
+	auto context = cl::Context(
+		cl::ContextProperties().setPlatform(platform),
+		std::vector<cl::Device>{device},
+		[](std::string const& error_info, std::vector<uint8_t> const&, int) {
+			std::cout << "error_info: " << error_info << '\n';
+		},
+		usr_data
+	);
+	auto queue = cl::CommandQueue(context, device, cl::CommandQueueProperties{});
+
+	benchmark_reduce(context, queue);
+	benchmark_sort(context, queue);
+
+	return 0;
+}
@@ -3,9 +3,39 @@
 
 #include "cppcl.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <type_traits>
 #include <unordered_map>
 #include <map>
+#include <vector>
+
+namespace {
+	// Full-range bounds must neither overflow in the kernel nor be rounded on the host:
+	// results have to cover both signs and a narrow range has to stay within its bounds.
+	template <typename IntegerType>
+	bool test_random_integer_range(cl::Context const& context, cl::CommandQueue & queue) {
+		const auto count = size_t{4096};
+		auto buffer = cl::Buffer<IntegerType>{context, cl::MemoryFlags{}.readWrite(true), count};
+		auto host = std::vector<IntegerType>(count);
+
+		const auto lowest = std::numeric_limits<IntegerType>::lowest();
+		const auto highest = std::numeric_limits<IntegerType>::max();
+		cl::generateRandom(queue, buffer, cl::RandomDistribution::integer(lowest, highest), 42);
+		queue.enqueueRead(buffer, host.begin(), host.end());
+		const auto full_range =
+			std::any_of(host.begin(), host.end(), [](IntegerType x) { return x < 0; }) &&
+			std::any_of(host.begin(), host.end(), [](IntegerType x) { return x > 0; });
+
+		cl::generateRandom(queue, buffer, cl::RandomDistribution::integer(IntegerType{-3}, IntegerType{3}), 42);
+		queue.enqueueRead(buffer, host.begin(), host.end());
+		const auto narrow_range = std::all_of(host.begin(), host.end(), [](IntegerType x) { return x >= -3 && x <= 3; });
+
+		std::cout << "random integer range (" << sizeof(IntegerType) * 8 << "-bit): "
+				  << ((full_range && narrow_range) ? "passed" : "FAILED") << '\n';
+		return full_range && narrow_range;
+	}
+}
 
 int main(int, const char**) {
 	auto platforms = cl::Platform::getPlatforms();
@@ -52,6 +82,11 @@ int main(int, const char**) {
 
 	std::cout << "Context created successfully!\n";
 
+	auto queue = cl::CommandQueue(context, device, cl::CommandQueueProperties{});
+	auto passed = test_random_integer_range<cl_int>(context, queue);
+	passed = test_random_integer_range<cl_long>(context, queue) && passed;
+	if (!passed) return 1;
+
 	std::ignore = context;
 	//std::cout << "Context information ...\n";
 	//std::cout << "\tReference Count = " << context.referenceCount() << '\n';